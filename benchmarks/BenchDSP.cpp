@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file BenchDSP.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Benchmarks for the filter, the LFOs and the envelope generators.
+*/
+/*----------------------------------------------------------------------------*/
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Fixtures.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Filter::process() with a cutoff that changes every block, like it does when
+it's modulated.
+Arguments: Filter::Type, block size
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_FilterProcess( benchmark::State &state )
+{
+   Filter::Type type = (Filter::Type)state.range( 0 );
+   size_t n = (size_t)state.range( 1 );
+   std::vector<float> left( n, 0.25f );
+   std::vector<float> right( n, -0.25f );
+
+   Filter filter;
+   filter.setType( type );
+   filter.setResonance( 0.5 );
+   state.SetLabel( Filter::toString( type ) );
+
+   double cutoff = 0.0;
+   for( auto _ : state )
+   {
+      cutoff += 0.01;
+      if( cutoff > 1.0 )
+         cutoff = 0.0;
+      filter.setCutoff( cutoff );
+      filter.process( left.data(), right.data(), (uint32_t)n, BENCHMARKS_SAMPLERATE );
+      benchmark::DoNotOptimize( left.data() );
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed( state.iterations() * (int64_t)n );
+}
+BENCHMARK( BM_FilterProcess )
+   ->ArgNames( { "type", "n" } )
+   ->ArgsProduct( {
+      { Filter::TYPE_NONE, Filter::TYPE_LOWPASS, Filter::TYPE_HIGHPASS },
+      { BENCHMARKS_MODSTEP_SAMPLES, BENCHMARKS_BLOCKSIZE } } );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+LFO::step() with one step per modulation interval.
+Arguments: LFO::Waveform, tempo sync
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_LFOStep( benchmark::State &state )
+{
+   LFO::Waveform waveform = (LFO::Waveform)state.range( 0 );
+   const double secs = BENCHMARKS_MODSTEP_SAMPLES / BENCHMARKS_SAMPLERATE;
+
+   LFO lfo;
+   lfo.setWaveform( waveform );
+   lfo.setFrequency( 5.0 );
+   lfo.setSyncEnabled( state.range( 1 ) != 0 );
+   lfo.noteOn();
+   state.SetLabel( LFO::toString( waveform ) );
+
+   for( auto _ : state )
+   {
+      lfo.step( secs, BENCHMARKS_BPM );
+      benchmark::DoNotOptimize( lfo.getValue() );
+   }
+}
+BENCHMARK( BM_LFOStep )
+   ->ArgNames( { "waveform", "sync" } )
+   ->ArgsProduct( {
+      benchmark::CreateDenseRange( LFO::Waveform_Sine, LFO::Waveform_Custom, 1 ),
+      { 0, 1 } } );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+ENV::step() with one step per modulation interval, cycling through all
+stages of the envelope.
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_ENVStep( benchmark::State &state )
+{
+   const double secs = BENCHMARKS_MODSTEP_SAMPLES / BENCHMARKS_SAMPLERATE;
+   const int64_t stepsPerNote = (int64_t)( 2.0 / secs );
+
+   ENV env;
+   env.setAttack( 0.2 );
+   env.setDecay( 0.3 );
+   env.setSustain( 0.5 );
+   env.setRelease( 0.3 );
+
+   int64_t nStep = 0;
+   for( auto _ : state )
+   {
+      if( nStep == 0 )
+      {
+         env.noteOn();
+      } else
+      if( nStep == stepsPerNote / 2 )
+      {
+         env.noteOff();
+      }
+      nStep = ( nStep + 1 ) % stepsPerNote;
+
+      env.step( secs, BENCHMARKS_BPM );
+      benchmark::DoNotOptimize( env.getValue() );
+   }
+}
+BENCHMARK( BM_ENVStep );
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file BenchIO.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Benchmarks for loading WAV files and for (de)serializing the engine.
+*/
+/*----------------------------------------------------------------------------*/
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <libxml/parser.h>
+
+#include <SamplerEngine/SampleLoader.h>
+#include <util.h>
+
+#include "Fixtures.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+WaveFile::load() from a file in the temp directory.
+Arguments: SampleReader::SampleFormat, number of channels, number of sample
+frames, load mode
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_WaveFileLoad( benchmark::State &state )
+{
+   SampleReader::SampleFormat format = (SampleReader::SampleFormat)state.range( 0 );
+   int nChannels = (int)state.range( 1 );
+   uint32_t nSamples = (uint32_t)state.range( 2 );
+   WaveFile::LoadMode loadMode = (WaveFile::LoadMode)state.range( 3 );
+   std::string fileName = Benchmarks::testWaveFileName( format, nChannels, nSamples );
+   state.SetLabel( SampleReader::toString( format ) );
+
+   for( auto _ : state )
+   {
+      WaveFile *pWave = WaveFile::load( fileName, loadMode );
+      if( !pWave )
+      {
+         state.SkipWithError( "Couldn't load the test wave" );
+         break;
+      }
+      benchmark::DoNotOptimize( pWave );
+      delete pWave;
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)( nSamples * nChannels * SampleReader::bytesPerSample( format ) ) );
+}
+BENCHMARK( BM_WaveFileLoad )
+   ->ArgNames( { "format", "channels", "frames", "loadmode" } )
+   ->ArgsProduct( { { SampleReader::SampleFormatInt8, SampleReader::SampleFormatInt16, SampleReader::SampleFormatInt24, SampleReader::SampleFormatFloat32 }, { 1, 2 }, { 44100, 441000 }, { WaveFile::LoadModeRead, WaveFile::LoadModeMap, WaveFile::LoadModeStream } } )
+   ->Unit( benchmark::kMicrosecond );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Loading a folder of files through the SampleLoader, like dropping them onto
+the keyboard does.
+Arguments: Number of threads, number of files
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_SampleLoaderFiles( benchmark::State &state )
+{
+   size_t numThreads = (size_t)state.range( 0 );
+   size_t numFiles = (size_t)state.range( 1 );
+   std::string fileName = Benchmarks::testWaveFileName( SampleReader::SampleFormatInt16, 2, 441000 );
+
+   for( auto _ : state )
+   {
+      SampleLoader loader;
+      for( size_t i = 0; i < numFiles; i++ )
+      {
+         loader.addFile( fileName, WaveFile::LoadModeRead );
+      }
+      loader.start( numThreads );
+      loader.wait();
+      benchmark::DoNotOptimize( loader.numDone() );
+   }
+
+   state.SetItemsProcessed( state.iterations() * (int64_t)numFiles );
+}
+BENCHMARK( BM_SampleLoaderFiles )
+   ->ArgNames( { "threads", "files" } )
+   ->ArgsProduct( { { 1, 2, 4, 8 }, { 64 } } )
+   ->UseRealTime()
+   ->Unit( benchmark::kMillisecond );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Engine::toXml() and converting the result to a string, like
+PluginProcessor::getStateInformation() does.
+Arguments: Number of samples
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_EngineToXml( benchmark::State &state )
+{
+   Engine *pEngine = Benchmarks::createTestEngine( (size_t)state.range( 0 ), 44100 );
+
+   size_t size = 0;
+   for( auto _ : state )
+   {
+      std::string xml = util::toString( pEngine->toXml() );
+      size = xml.size();
+      benchmark::DoNotOptimize( xml.data() );
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)size );
+   delete pEngine;
+}
+BENCHMARK( BM_EngineToXml )
+   ->ArgName( "samples" )
+   ->Arg( 1 )->Arg( 16 )->Arg( 64 )
+   ->Unit( benchmark::kMillisecond );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Parsing a state and Engine::fromXml(), like
+PluginProcessor::setStateInformation() does.
+Arguments: Number of samples
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_EngineFromXml( benchmark::State &state )
+{
+   Engine *pEngine = Benchmarks::createTestEngine( (size_t)state.range( 0 ), 44100 );
+   std::string xml = util::toString( pEngine->toXml() );
+   delete pEngine;
+
+   for( auto _ : state )
+   {
+      xmlDocPtr doc = xmlReadMemory( xml.c_str(), (int)xml.size(), "noname.xml", nullptr, XML_PARSE_HUGE );
+      if( !doc )
+      {
+         state.SkipWithError( "Couldn't parse the state" );
+         break;
+      }
+
+      Engine *pLoaded = Engine::fromXml( xmlDocGetRootElement( doc ) );
+      xmlFreeDoc( doc );
+      benchmark::DoNotOptimize( pLoaded );
+      delete pLoaded;
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)xml.size() );
+}
+BENCHMARK( BM_EngineFromXml )
+   ->ArgName( "samples" )
+   ->Arg( 1 )->Arg( 16 )->Arg( 64 )
+   ->Unit( benchmark::kMillisecond );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+util::base64encode()
+Arguments: Number of bytes
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_Base64Encode( benchmark::State &state )
+{
+   std::vector<uint8_t> data( (size_t)state.range( 0 ) );
+   for( size_t i = 0; i < data.size(); i++ )
+   {
+      data[i] = (uint8_t)( i * 31 );
+   }
+
+   for( auto _ : state )
+   {
+      std::string s = util::base64encode( data );
+      benchmark::DoNotOptimize( s.data() );
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)data.size() );
+}
+BENCHMARK( BM_Base64Encode )
+   ->ArgName( "bytes" )
+   ->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 22 );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+util::base64decode()
+Arguments: Number of decoded bytes
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_Base64Decode( benchmark::State &state )
+{
+   std::vector<uint8_t> data( (size_t)state.range( 0 ) );
+   for( size_t i = 0; i < data.size(); i++ )
+   {
+      data[i] = (uint8_t)( i * 31 );
+   }
+   std::string s = util::base64encode( data );
+
+   for( auto _ : state )
+   {
+      std::vector<uint8_t> d = util::base64decode( s );
+      benchmark::DoNotOptimize( d.data() );
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)data.size() );
+}
+BENCHMARK( BM_Base64Decode )
+   ->ArgName( "bytes" )
+   ->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 22 );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Engine::saveState(), like PluginProcessor::getStateInformation() does.
+Arguments: Number of samples, BinaryState::Compression
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_EngineSaveState( benchmark::State &state )
+{
+   Engine *pEngine = Benchmarks::createTestEngine( (size_t)state.range( 0 ), 44100 );
+   BinaryState::Compression compression = (BinaryState::Compression)state.range( 1 );
+   pEngine->setStateCompression( compression );
+   state.SetLabel( BinaryState::toString( compression ) );
+
+   std::vector<uint8_t> data;
+   for( auto _ : state )
+   {
+      BinaryState binaryState;
+      pEngine->saveState( binaryState );
+      data.resize( binaryState.size() );
+      binaryState.write( data.data() );
+      benchmark::DoNotOptimize( data.data() );
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)data.size() );
+   delete pEngine;
+}
+BENCHMARK( BM_EngineSaveState )
+   ->ArgNames( { "samples", "compression" } )
+   ->ArgsProduct( { { 1, 16, 64 }, { BinaryState::CompressionNone, BinaryState::CompressionZlib } } )
+   ->Unit( benchmark::kMillisecond );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Engine::loadState(), like PluginProcessor::setStateInformation() does.
+Arguments: Number of samples, BinaryState::Compression
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_EngineLoadState( benchmark::State &state )
+{
+   Engine *pEngine = Benchmarks::createTestEngine( (size_t)state.range( 0 ), 44100 );
+   BinaryState::Compression compression = (BinaryState::Compression)state.range( 1 );
+   pEngine->setStateCompression( compression );
+   state.SetLabel( BinaryState::toString( compression ) );
+
+   BinaryState binaryState;
+   pEngine->saveState( binaryState );
+   std::vector<uint8_t> data( binaryState.size() );
+   binaryState.write( data.data() );
+   delete pEngine;
+
+   for( auto _ : state )
+   {
+      Engine *pLoaded = Engine::loadState( data.data(), data.size() );
+      if( !pLoaded )
+      {
+         state.SkipWithError( "Couldn't load the state" );
+         break;
+      }
+      benchmark::DoNotOptimize( pLoaded );
+      delete pLoaded;
+   }
+
+   state.SetBytesProcessed( state.iterations() * (int64_t)data.size() );
+}
+BENCHMARK( BM_EngineLoadState )
+   ->ArgNames( { "samples", "compression" } )
+   ->ArgsProduct( { { 1, 16, 64 }, { BinaryState::CompressionNone, BinaryState::CompressionZlib } } )
+   ->Unit( benchmark::kMillisecond );
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file BenchPart.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Benchmarks for looking up and triggering the samples of a part and
+for its voice bookkeeping.
+*/
+/*----------------------------------------------------------------------------*/
+#include <list>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SamplerEngine/ZoneTable.h>
+
+#include "Fixtures.h"
+
+#define BENCHPART_WAVESAMPLES 4410
+#define BENCHPART_CHURNBLOCKSIZE 32
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Create zones laid out like a round-robin multisample: groups of 8 zones
+share a range of 4 notes, each group is split into 4 velocity layers.
+The zones have no wave, they are only used for the lookup.
+\param numZones The number of zones
+\return The zones, to be deleted by the caller
+*/
+/*----------------------------------------------------------------------------*/
+static std::list<Sample *> createZones( size_t numZones )
+{
+   std::list<Sample *> zones;
+
+   for( size_t i = 0; i < numZones; i++ )
+   {
+      int minNote = (int)( ( i / 8 ) * 4 % 128 );
+      Sample *pSample = new Sample( "Zone", nullptr, minNote, minNote + 3, 0 );
+      int minVel = (int)( i % 4 ) * 32;
+      pSample->setMinVelocity( minVel );
+      pSample->setMaxVelocity( minVel + 31 );
+      zones.push_back( pSample );
+   }
+
+   return( zones );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Building the note/velocity index of a part, which happens off the audio
+thread whenever zones change.
+Arguments: Number of zones
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_ZoneTableBuild( benchmark::State &state )
+{
+   std::list<Sample *> zones = createZones( (size_t)state.range( 0 ) );
+
+   for( auto _ : state )
+   {
+      ZoneTable table( zones );
+      benchmark::DoNotOptimize( table.numEntries() );
+   }
+
+   for( Sample *pSample : zones )
+   {
+      delete pSample;
+   }
+}
+BENCHMARK( BM_ZoneTableBuild )
+   ->ArgName( "zones" )
+   ->RangeMultiplier( 4 )
+   ->Range( 64, 4096 )
+   ->Unit( benchmark::kMicrosecond );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Looking up the zones of all 128 notes, as done on each note-on. The time
+per lookup should not depend on the number of zones in the part.
+Arguments: Number of zones
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_ZoneTableLookup( benchmark::State &state )
+{
+   std::list<Sample *> zones = createZones( (size_t)state.range( 0 ) );
+   ZoneTable table( zones );
+
+   for( auto _ : state )
+   {
+      for( int note = 0; note < ZONETABLE_NUMNOTES; note++ )
+      {
+         size_t numZones = table.numZones( note, 100 );
+         Sample *const *ppZones = table.zones( note, 100 );
+         for( size_t i = 0; i < numZones; i++ )
+         {
+            benchmark::DoNotOptimize( ppZones[i] );
+         }
+      }
+   }
+   state.SetItemsProcessed( (int64_t)state.iterations() * ZONETABLE_NUMNOTES );
+
+   for( Sample *pSample : zones )
+   {
+      delete pSample;
+   }
+}
+BENCHMARK( BM_ZoneTableLookup )
+   ->ArgName( "zones" )
+   ->RangeMultiplier( 4 )
+   ->Range( 64, 4096 );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Voice bookkeeping of a part under note churn: the given number of notes are
+held, one of them is released and retriggered per iteration, then a short
+block is rendered, which also removes the voices that have finished.
+Arguments: Number of held notes
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_PartVoiceChurn( benchmark::State &state )
+{
+   Engine engine;
+   engine.prepareToPlay( BENCHPART_CHURNBLOCKSIZE );
+   engine.setMaxVoices( SAMPLERENGINE_MAXVOICESPERPART );
+
+   Part *pPart = engine.getPart( 0 );
+   pPart->setMaxVoices( SAMPLERENGINE_MAXVOICESPERPART );
+   for( int note = 0; note < ZONETABLE_NUMNOTES; note++ )
+   {
+      WaveFile *pWave = Benchmarks::loadTestWave( SampleReader::SampleFormatInt16, 2, BENCHPART_WAVESAMPLES );
+      if( !pWave )
+      {
+         state.SkipWithError( "Couldn't load the test wave" );
+         return;
+      }
+
+      Sample *pSample = new Sample( "Churn", pWave, note, note, 0 );
+      pSample->setPlayMode( Sample::PlayModeLoopUntilRelease );
+      pPart->addSample( pSample );
+   }
+
+   std::vector<float> left( BENCHPART_CHURNBLOCKSIZE );
+   std::vector<float> right( BENCHPART_CHURNBLOCKSIZE );
+   std::vector<OutputBus> buses;
+   buses.push_back( OutputBus( BENCHPART_CHURNBLOCKSIZE, { left.data(), right.data() } ) );
+
+   int numNotes = (int)state.range( 0 );
+   for( int note = 0; note < numNotes; note++ )
+   {
+      engine.noteOn( 0, note, 100 );
+   }
+
+   int note = 0;
+   for( auto _ : state )
+   {
+      engine.noteOff( 0, note, 0 );
+      engine.noteOn( 0, note, 100 );
+      engine.process( buses, BENCHMARKS_SAMPLERATE, BENCHMARKS_BPM );
+      benchmark::DoNotOptimize( left.data() );
+      note = ( note + 1 ) % numNotes;
+   }
+}
+BENCHMARK( BM_PartVoiceChurn )
+   ->ArgName( "notes" )
+   ->RangeMultiplier( 4 )
+   ->Range( 4, 64 );
@@ -0,0 +1,329 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file BenchVoice.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Benchmarks for rendering voices and evaluating the modulation matrix.
+*/
+/*----------------------------------------------------------------------------*/
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Fixtures.h"
+
+#define BENCHVOICE_WAVESAMPLES 44100
+#define BENCHVOICE_STREAMEDWAVESAMPLES 441000
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\class VoiceFixture
+\date  2026-10-17
+Everything needed to render a single voice outside of a part: the sample,
+the part providing pitchbend/controllers/interpolation and the scratch
+memory.
+*/
+/*----------------------------------------------------------------------------*/
+class VoiceFixture
+{
+public:
+   VoiceFixture( SampleReader::SampleFormat format, int nChannels, size_t blockSize,
+                 uint32_t nSamples = BENCHVOICE_WAVESAMPLES, WaveFile::LoadMode loadMode = WaveFile::LoadModeRead,
+                 WaveFile::Storage storage = WaveFile::StorageRaw ) :
+      m_Part( 0 ),
+      m_pSample( nullptr ),
+      m_Left( blockSize ),
+      m_Right( blockSize ),
+      m_ScratchLeft( blockSize ),
+      m_ScratchRight( blockSize ),
+      m_LeftAmp( blockSize ),
+      m_RightAmp( blockSize ),
+      m_Positions( blockSize )
+   {
+      WaveFile *pWave = Benchmarks::loadTestWave( format, nChannels, nSamples, loadMode, storage );
+      if( pWave )
+      {
+         m_pSample = new Sample( "Benchmark", pWave, 0, 127, 0 );
+         m_pSample->setBaseNote( 60 );
+      }
+
+      m_Scratch.pLeft = m_ScratchLeft.data();
+      m_Scratch.pRight = m_ScratchRight.data();
+      m_Scratch.pLeftAmp = m_LeftAmp.data();
+      m_Scratch.pRightAmp = m_RightAmp.data();
+      m_Scratch.pPositions = m_Positions.data();
+      m_Scratch.size = blockSize;
+   }
+
+   ~VoiceFixture()
+   {
+      delete m_pSample;
+   }
+
+   // A note a fifth above the base note, so the interpolation has to do actual work
+   void start()
+   {
+      m_Voice.start( &m_Part, m_pSample, 67, 100, 0 );
+   }
+
+   bool process()
+   {
+      return( m_Voice.process( m_Left.data(), m_Right.data(), m_Left.size(), m_Scratch, BENCHMARKS_SAMPLERATE, BENCHMARKS_BPM ) );
+   }
+
+   Part m_Part;
+   Sample *m_pSample;
+   Voice m_Voice;
+   ScratchBuffer m_Scratch;
+   std::vector<float> m_Left;
+   std::vector<float> m_Right;
+   std::vector<float> m_ScratchLeft;
+   std::vector<float> m_ScratchRight;
+   std::vector<float> m_LeftAmp;
+   std::vector<float> m_RightAmp;
+   std::vector<double> m_Positions;
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Render a block with the voice, restarting it when it has ended.
+*/
+/*----------------------------------------------------------------------------*/
+static void runVoice( benchmark::State &state, VoiceFixture &f )
+{
+   f.start();
+   for( auto _ : state )
+   {
+      if( !f.process() )
+      {
+         f.start();
+      }
+      benchmark::DoNotOptimize( f.m_Left.data() );
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed( state.iterations() * (int64_t)f.m_Left.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Voice::process() with raw storage.
+Arguments: SampleReader::SampleFormat, number of channels, Sample::PlayMode,
+SampleReader::Interpolation
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_VoiceProcess( benchmark::State &state )
+{
+   VoiceFixture f( (SampleReader::SampleFormat)state.range( 0 ), (int)state.range( 1 ), BENCHMARKS_BLOCKSIZE );
+   if( !f.m_pSample )
+   {
+      state.SkipWithError( "Couldn't load the test wave" );
+      return;
+   }
+
+   Sample::PlayMode playMode = (Sample::PlayMode)state.range( 2 );
+   SampleReader::Interpolation interpolation = (SampleReader::Interpolation)state.range( 3 );
+   f.m_pSample->setPlayMode( playMode );
+   f.m_Part.setInterpolation( interpolation );
+   state.SetLabel( SampleReader::toString( f.m_pSample->getWave()->sampleFormat() ) + "/" + Sample::toString( playMode ) + "/" + SampleReader::toString( interpolation ) );
+
+   runVoice( state, f );
+}
+BENCHMARK( BM_VoiceProcess )
+   ->ArgNames( { "format", "channels", "playmode", "interpolation" } )
+   ->ArgsProduct( {
+      { SampleReader::SampleFormatInt8, SampleReader::SampleFormatInt16, SampleReader::SampleFormatInt24, SampleReader::SampleFormatFloat32 },
+      { 1, 2 },
+      { Sample::PlayModeStandard, Sample::PlayModeLoop, Sample::PlayModeShot, Sample::PlayModeLoopUntilRelease },
+      { SampleReader::InterpolationNone, SampleReader::InterpolationLinear, SampleReader::InterpolationHermite, SampleReader::InterpolationSinc } } );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Voice::process() with the wave decoded to planar float.
+Arguments: Number of channels, SampleReader::Interpolation
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_VoiceProcessFloatPlanar( benchmark::State &state )
+{
+   VoiceFixture f( SampleReader::SampleFormatInt16, (int)state.range( 0 ), BENCHMARKS_BLOCKSIZE,
+                   BENCHVOICE_WAVESAMPLES, WaveFile::LoadModeRead, WaveFile::StorageFloatPlanar );
+   if( !f.m_pSample )
+   {
+      state.SkipWithError( "Couldn't load the test wave" );
+      return;
+   }
+
+   SampleReader::Interpolation interpolation = (SampleReader::Interpolation)state.range( 1 );
+   f.m_pSample->setPlayMode( Sample::PlayModeLoop );
+   f.m_Part.setInterpolation( interpolation );
+   state.SetLabel( SampleReader::toString( interpolation ) );
+
+   runVoice( state, f );
+}
+BENCHMARK( BM_VoiceProcessFloatPlanar )
+   ->ArgNames( { "channels", "interpolation" } )
+   ->ArgsProduct( {
+      { 1, 2 },
+      { SampleReader::InterpolationNone, SampleReader::InterpolationLinear, SampleReader::InterpolationHermite, SampleReader::InterpolationSinc } } );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Voice::process() with a wave streamed from disk, which is longer than its
+resident head. The benchmark renders much faster than realtime, so the
+underruns counter shows how well the I/O thread keeps up.
+Arguments: Number of channels, SampleReader::Interpolation
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_VoiceProcessStreamed( benchmark::State &state )
+{
+   VoiceFixture f( SampleReader::SampleFormatInt16, (int)state.range( 0 ), BENCHMARKS_BLOCKSIZE, BENCHVOICE_STREAMEDWAVESAMPLES, WaveFile::LoadModeStream );
+   if( !f.m_pSample || !f.m_pSample->getWave()->isStreamed() )
+   {
+      state.SkipWithError( "Couldn't load the test wave" );
+      return;
+   }
+
+   SampleReader::Interpolation interpolation = (SampleReader::Interpolation)state.range( 1 );
+   f.m_pSample->setPlayMode( Sample::PlayModeStandard );
+   f.m_Part.setInterpolation( interpolation );
+   state.SetLabel( SampleReader::toString( interpolation ) );
+
+   uint64_t numUnderruns = DiskStreamer::instance().numUnderruns();
+   runVoice( state, f );
+   f.m_Voice.stop();
+
+   state.counters["underruns"] = (double)( DiskStreamer::instance().numUnderruns() - numUnderruns );
+}
+BENCHMARK( BM_VoiceProcessStreamed )
+   ->ArgNames( { "channels", "interpolation" } )
+   ->ArgsProduct( {
+      { 1, 2 },
+      { SampleReader::InterpolationLinear, SampleReader::InterpolationSinc } } );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Modulation matrix evaluation: Voice::process() with one modulation step per
+block and the given number of enabled modulation slots. Comparing against
+0 slots isolates the cost of the matrix.
+Arguments: Number of enabled slots
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_ModMatrix( benchmark::State &state )
+{
+   static const ModMatrix::ModSrc srcs[] = {
+      ModMatrix::ModSrc_LFO1, ModMatrix::ModSrc_EG2, ModMatrix::ModSrc_LFO2, ModMatrix::ModSrc_Velocity, ModMatrix::ModSrc_LFO3 };
+   static const ModMatrix::ModDest dests[] = {
+      ModMatrix::ModDest_Pitch, ModMatrix::ModDest_FilterCutoff, ModMatrix::ModDest_Pan, ModMatrix::ModDest_Amp, ModMatrix::ModDest_FilterResonance };
+
+   VoiceFixture f( SampleReader::SampleFormatInt16, 2, BENCHMARKS_MODSTEP_SAMPLES );
+   if( !f.m_pSample )
+   {
+      state.SkipWithError( "Couldn't load the test wave" );
+      return;
+   }
+
+   f.m_pSample->setPlayMode( Sample::PlayModeLoop );
+   f.m_pSample->getFilter()->setType( Filter::TYPE_LOWPASS );
+
+   ModMatrix *pModMatrix = f.m_pSample->getModMatrix();
+   size_t numEnabled = (size_t)state.range( 0 );
+   for( size_t i = 0; i < pModMatrix->numSlots(); i++ )
+   {
+      ModMatrix::ModSlot *pSlot = pModMatrix->getSlot( i );
+      pSlot->setSrc( srcs[i % ( sizeof( srcs ) / sizeof( srcs[0] ) )] );
+      pSlot->setDest( dests[i % ( sizeof( dests ) / sizeof( dests[0] ) )] );
+      pSlot->setMathFunc( ModMatrix::MathFunc_X );
+      pSlot->setAmount( 0.1 );
+      pSlot->setEnabled( i < numEnabled );
+   }
+
+   runVoice( state, f );
+}
+BENCHMARK( BM_ModMatrix )
+   ->ArgName( "slots" )
+   ->DenseRange( 0, SAMPLERENGINE_NUMMODSLOTS );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Voice::process() with an LFO modulating pitch and cutoff at the given
+modulation rate, optionally interpolated to audio rate.
+Arguments: Modulation rate in Hz, audio rate for pitch and cutoff
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_ModulationRate( benchmark::State &state )
+{
+   VoiceFixture f( SampleReader::SampleFormatInt16, 2, BENCHMARKS_BLOCKSIZE );
+   if( !f.m_pSample )
+   {
+      state.SkipWithError( "Couldn't load the test wave" );
+      return;
+   }
+
+   f.m_pSample->setPlayMode( Sample::PlayModeLoop );
+   f.m_pSample->getFilter()->setType( Filter::TYPE_LOWPASS );
+   *f.m_pSample->getModMatrix()->getSlot( 0 ) = ModMatrix::ModSlot( ModMatrix::ModSrc_LFO1, ModMatrix::ModSrc_None, ModMatrix::ModDest_Pitch, ModMatrix::MathFunc_X, 0.5, true );
+   *f.m_pSample->getModMatrix()->getSlot( 1 ) = ModMatrix::ModSlot( ModMatrix::ModSrc_LFO1, ModMatrix::ModSrc_None, ModMatrix::ModDest_FilterCutoff, ModMatrix::MathFunc_X, 1.0, true );
+
+   bool audioRate = state.range( 1 ) != 0;
+   f.m_Part.setModulationRate( (double)state.range( 0 ) );
+   f.m_Part.setAudioRateModulation( ModMatrix::ModDest_Pitch, audioRate );
+   f.m_Part.setAudioRateModulation( ModMatrix::ModDest_FilterCutoff, audioRate );
+
+   runVoice( state, f );
+}
+BENCHMARK( BM_ModulationRate )
+   ->ArgNames( { "hz", "audiorate" } )
+   ->ArgsProduct( {
+      { 100, 345, 1000, 4000 },
+      { 0, 1 } } );
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+ModMatrix::calc() for each math function.
+Arguments: ModMatrix::MathFunc
+*/
+/*----------------------------------------------------------------------------*/
+static void BM_ModMatrixCalc( benchmark::State &state )
+{
+   ModMatrix::MathFunc func = (ModMatrix::MathFunc)state.range( 0 );
+   state.SetLabel( ModMatrix::toString( func ) );
+
+   double v = 0.5;
+   for( auto _ : state )
+   {
+      benchmark::DoNotOptimize( v );
+      double r = ModMatrix::calc( func, v );
+      benchmark::DoNotOptimize( r );
+   }
+}
+BENCHMARK( BM_ModMatrixCalc )
+   ->ArgName( "func" )
+   ->DenseRange( ModMatrix::MathFunc_X, ModMatrix::MathFunc_Neg );
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file Fixtures.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Test data shared by the benchmarks. The WAV files are synthesized into
+the temp directory on first use, so the benchmarks don't depend on any files
+outside of the repository.
+*/
+/*----------------------------------------------------------------------------*/
+#include <math.h>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#include <util.h>
+
+#include "Fixtures.h"
+
+#define FIXTURES_FREQUENCY 440.0
+#define FIXTURES_AMPLITUDE 0.8
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param file The output stream
+\param v The value to write in little endian byte order
+\param nBytes The number of bytes to write
+*/
+/*----------------------------------------------------------------------------*/
+static void writeLE( std::ofstream &file, uint32_t v, int nBytes )
+{
+   for( int i = 0; i < nBytes; i++ )
+   {
+      file.put( (char)( ( v >> ( i * 8 ) ) & 0xff ) );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Write a looped WAV file containing a sine wave.
+\param fileName The file name
+\param format The sample format
+\param nChannels 1 or 2
+\param nSamples The number of sample frames
+\return true on success
+*/
+/*----------------------------------------------------------------------------*/
+static bool writeTestWave( const std::string &fileName, SamplerEngine::SampleReader::SampleFormat format, int nChannels, uint32_t nSamples )
+{
+   std::ofstream file( fileName, std::ios_base::binary | std::ios_base::trunc );
+   if( !file )
+      return( false );
+
+   const bool isFloat = format == SamplerEngine::SampleReader::SampleFormatFloat32 ||
+                        format == SamplerEngine::SampleReader::SampleFormatFloat64;
+   const uint32_t nBytes = (uint32_t)SamplerEngine::SampleReader::bytesPerSample( format );
+   const uint32_t bytesPerFrame = (uint32_t)nChannels * nBytes;
+   const uint32_t dataLen = bytesPerFrame * nSamples;
+   const uint32_t fmtLen = 16;
+   const uint32_t smplLen = 36 + 24;
+
+   file.write( "RIFF", 4 );
+   writeLE( file, 4 + ( 8 + fmtLen ) + ( 8 + smplLen ) + ( 8 + dataLen ), 4 );
+   file.write( "WAVE", 4 );
+
+   file.write( "fmt ", 4 );
+   writeLE( file, fmtLen, 4 );
+   writeLE( file, isFloat ? WAVEFILE_FORMAT_IEEEFLOAT : WAVEFILE_FORMAT_PCM, 2 );
+   writeLE( file, (uint32_t)nChannels, 2 );
+   writeLE( file, (uint32_t)BENCHMARKS_SAMPLERATE, 4 );
+   writeLE( file, (uint32_t)BENCHMARKS_SAMPLERATE * bytesPerFrame, 4 );
+   writeLE( file, bytesPerFrame, 2 );
+   writeLE( file, nBytes * 8, 2 );
+
+   // One forward loop over the second half of the wave
+   file.write( "smpl", 4 );
+   writeLE( file, smplLen, 4 );
+   for( int i = 0; i < 7; i++ )
+   {
+      writeLE( file, 0, 4 );
+   }
+   writeLE( file, 1, 4 );
+   writeLE( file, 0, 4 );
+   writeLE( file, 0, 4 );
+   writeLE( file, 0, 4 );
+   writeLE( file, nSamples / 2, 4 );
+   writeLE( file, nSamples - 1, 4 );
+   writeLE( file, 0, 4 );
+   writeLE( file, 0, 4 );
+
+   file.write( "data", 4 );
+   writeLE( file, dataLen, 4 );
+   for( uint32_t i = 0; i < nSamples; i++ )
+   {
+      for( int c = 0; c < nChannels; c++ )
+      {
+         double phase = 2.0 * M_PI * FIXTURES_FREQUENCY * (double)i / BENCHMARKS_SAMPLERATE;
+         double v = FIXTURES_AMPLITUDE * sin( phase + c * ( M_PI / 2.0 ) );
+         if( format == SamplerEngine::SampleReader::SampleFormatInt8 )
+         {
+            writeLE( file, (uint32_t)( 128.0 + v * 127.0 ), 1 );
+         } else
+         if( format == SamplerEngine::SampleReader::SampleFormatFloat32 )
+         {
+            float f = (float)v;
+            file.write( (const char *)&f, sizeof( f ) );
+         } else
+         if( format == SamplerEngine::SampleReader::SampleFormatFloat64 )
+         {
+            file.write( (const char *)&v, sizeof( v ) );
+         } else
+         {
+            // Integer formats are left-justified in their container
+            int32_t i32 = (int32_t)( v * 2147483647.0 );
+            writeLE( file, (uint32_t)i32 >> ( 32 - ( nBytes * 8 ) ), (int)nBytes );
+         }
+      }
+   }
+
+   return( file.good() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Get a test WAV file with the given format, creating it if necessary.
+\param format The sample format
+\param nChannels 1 or 2
+\param nSamples The number of sample frames
+\return The file name
+*/
+/*----------------------------------------------------------------------------*/
+std::string Benchmarks::testWaveFileName( SamplerEngine::SampleReader::SampleFormat format, int nChannels, uint32_t nSamples )
+{
+   static std::map<std::string, bool> created;
+
+   std::filesystem::path dir = std::filesystem::temp_directory_path() / "OvervoltageBenchmarks";
+   std::filesystem::create_directories( dir );
+   std::string fileName = ( dir / stdformat( "test-{}-{}ch-{}.wav", (int)format, nChannels, nSamples ) ).string();
+
+   if( !created[fileName] )
+   {
+      created[fileName] = writeTestWave( fileName, format, nChannels, nSamples );
+   }
+
+   return( fileName );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param format The sample format
+\param nChannels 1 or 2
+\param nSamples The number of sample frames
+\param loadMode How the test wave is loaded
+\param storage How the test wave's data is kept in memory
+\return A newly loaded test wave or nullptr
+*/
+/*----------------------------------------------------------------------------*/
+SamplerEngine::WaveFile *Benchmarks::loadTestWave( SamplerEngine::SampleReader::SampleFormat format, int nChannels, uint32_t nSamples,
+                                                   SamplerEngine::WaveFile::LoadMode loadMode, SamplerEngine::WaveFile::Storage storage )
+{
+   return( SamplerEngine::WaveFile::load( testWaveFileName( format, nChannels, nSamples ), loadMode, storage ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Create an engine with the given number of samples, distributed over the parts
+and spread across the keyboard.
+\param numSamples The number of samples
+\param nSamplesPerWave The length of each sample's wave in sample frames
+\return The engine
+*/
+/*----------------------------------------------------------------------------*/
+SamplerEngine::Engine *Benchmarks::createTestEngine( size_t numSamples, uint32_t nSamplesPerWave )
+{
+   SamplerEngine::Engine *pEngine = new SamplerEngine::Engine();
+
+   for( size_t i = 0; i < numSamples; i++ )
+   {
+      SamplerEngine::WaveFile *pWave = loadTestWave( SamplerEngine::SampleReader::SampleFormatInt16, 2, nSamplesPerWave );
+      if( !pWave )
+         continue;
+
+      int note = (int)( i % 128 );
+      SamplerEngine::Sample *pSample = new SamplerEngine::Sample( stdformat( "Sample {}", i ), pWave, note, note, 0 );
+      pEngine->getPart( i % SAMPLERENGINE_NUMPARTS )->addSample( pSample );
+   }
+
+   return( pEngine );
+}
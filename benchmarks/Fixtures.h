@@ -0,0 +1,51 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file Fixtures.h
+\author Christian Nowak <chnowak@web.de>
+\brief Test data shared by the benchmarks.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __FIXTURES_H__
+#define __FIXTURES_H__
+
+#include <stdint.h>
+#include <string>
+
+#include <SamplerEngine/SamplerEngine.h>
+
+#define BENCHMARKS_SAMPLERATE 44100.0
+#define BENCHMARKS_BPM 120.0
+#define BENCHMARKS_BLOCKSIZE 512
+// Length of one modulation step at VOICE_DEFAULT_MODRATE and BENCHMARKS_SAMPLERATE
+#define BENCHMARKS_MODSTEP_SAMPLES 128
+
+//==============================================================================
+namespace Benchmarks
+{
+   std::string testWaveFileName( SamplerEngine::SampleReader::SampleFormat format, int nChannels, uint32_t nSamples );
+   SamplerEngine::WaveFile *loadTestWave( SamplerEngine::SampleReader::SampleFormat format, int nChannels, uint32_t nSamples,
+                                          SamplerEngine::WaveFile::LoadMode loadMode = SamplerEngine::WaveFile::LoadModeRead,
+                                          SamplerEngine::WaveFile::Storage storage = SamplerEngine::WaveFile::StorageRaw );
+   SamplerEngine::Engine *createTestEngine( size_t numSamples, uint32_t nSamplesPerWave );
+}
+
+#endif
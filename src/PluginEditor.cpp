@@ -252,6 +252,7 @@ void PluginEditor::buttonClicked( Button *pButton )
                if( pRoot )
                {
                   processor().samplerEngine()->importPart( currentPart(), pRoot );
+                  activatePart( currentPart() );
                   repaint();
                }
                xmlFreeDoc( doc );
@@ -47,9 +47,11 @@ PluginProcessor::PluginProcessor()
       .withOutput( "Output 6", juce::AudioChannelSet::stereo(), true )
       .withOutput( "Output 7", juce::AudioChannelSet::stereo(), true )
       .withOutput( "Output 8", juce::AudioChannelSet::stereo(), true )
-   ), m_pEditor( nullptr )
+   ), m_Engine( new SamplerEngine::Engine() ),
+   m_pEditor( nullptr ),
+   m_sampleRate( 44100.0 ),
+   m_samplesPerBlock( SAMPLERENGINE_DEFAULTBLOCKSIZE )
 {
-   m_pEngine = new SamplerEngine::Engine( this );
 }
 
 
@@ -60,7 +62,6 @@ Destructor
 /*----------------------------------------------------------------------------*/
 PluginProcessor::~PluginProcessor()
 {
-   delete m_pEngine;
 }
 
 
@@ -200,6 +201,8 @@ void PluginProcessor::prepareToPlay( double sampleRate, int samplesPerBlock )
 {
    m_sampleRate = sampleRate;
    m_samplesPerBlock = samplesPerBlock;
+
+   samplerEngine()->prepareToPlay( (size_t)samplesPerBlock );
 }
 
 
@@ -239,7 +242,7 @@ bool PluginProcessor::isBusesLayoutSupported( const BusesLayout& layouts ) const
 /*----------------------------------------------------------------------------*/
 std::list<SamplerEngine::Sample *> &PluginProcessor::samples()
 {
-   return( m_pEngine->samples( m_pEditor->currentPart() ) );
+   return( samplerEngine()->samples( m_pEditor->currentPart() ) );
 }
 
 
@@ -250,7 +253,7 @@ std::list<SamplerEngine::Sample *> &PluginProcessor::samples()
 /*----------------------------------------------------------------------------*/
 const std::list<SamplerEngine::Sample *> &PluginProcessor::constSamples() const
 {
-   return( m_pEngine->constSamples( m_pEditor->currentPart() ) );
+   return( samplerEngine()->constSamples( m_pEditor->currentPart() ) );
 }
 
 
@@ -266,7 +269,8 @@ Callback function to register MIDI note on events (from juce::MidiKeyboardStateL
 void PluginProcessor::handleNoteOn( MidiKeyboardState */*pSource*/, int midiChannel, int midiNoteNumber, float velocity )
 {
    int vel = (int)( 127 * velocity );
-   m_pEngine->noteOn( (size_t)( midiChannel - 1 ), midiNoteNumber, vel );
+   EngineSnapshot::Reader engine( m_Engine );
+   engine->noteOn( (size_t)( midiChannel - 1 ), midiNoteNumber, vel );
 }
 
 
@@ -282,7 +286,8 @@ Callback function to register MIDI note off events (from juce::MidiKeyboardState
 void PluginProcessor::handleNoteOff( MidiKeyboardState */*pSource*/, int midiChannel, int midiNoteNumber, float velocity )
 {
    int vel = (int)( 127 * velocity );
-   m_pEngine->noteOff( (size_t)( midiChannel - 1), midiNoteNumber, vel );
+   EngineSnapshot::Reader engine( m_Engine );
+   engine->noteOff( (size_t)( midiChannel - 1), midiNoteNumber, vel );
 }
 
 
@@ -296,7 +301,8 @@ This function gets called when the MIDI keyboard's pitch wheel position has chan
 /*----------------------------------------------------------------------------*/
 void PluginProcessor::handlePitchbend( int midiChannel, double v )
 {
-   m_pEngine->pitchbend( (size_t)( midiChannel - 1 ), v );
+   EngineSnapshot::Reader engine( m_Engine );
+   engine->pitchbend( (size_t)( midiChannel - 1 ), v );
 }
 
 
@@ -311,7 +317,8 @@ This function gets called when a MIDI controller has changed.
 /*----------------------------------------------------------------------------*/
 void PluginProcessor::handleControllerChange( int midiChannel, int ccNum, double v )
 {
-   m_pEngine->controllerChange( (size_t)( midiChannel - 1 ), ccNum, v );
+   EngineSnapshot::Reader engine( m_Engine );
+   engine->controllerChange( (size_t)( midiChannel - 1 ), ccNum, v );
 }
 
 
@@ -352,6 +359,10 @@ This function gets called by the host when new audio shall be generated.
 void PluginProcessor::processBlock( juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer& midiMessages )
 {
+   // The engine stays alive until the end of the block, even if it gets
+   // replaced in the meantime.
+   EngineSnapshot::Reader engine( m_Engine );
+
    double bpm = 120.0;
    if( auto p = getPlayHead()->getPosition() )
    {
@@ -361,35 +372,8 @@ void PluginProcessor::processBlock( juce::AudioBuffer<float>& buffer,
       }
    }
 
-   for (const juce::MidiMessageMetadata metadata : midiMessages)
-   {
-      const juce::MidiMessage msg = metadata.getMessage();
-      if( msg.isNoteOn() )
-      {
-         noteOn( msg.getChannel(), msg.getNoteNumber(), msg.getVelocity() / 127.0f );
-      } else
-      if( msg.isNoteOff() )
-      {
-         noteOff( msg.getChannel(), msg.getNoteNumber(), msg.getVelocity() / 127.0f );
-      } else
-      if( msg.isPitchWheel() )
-      {
-         int pitchValue = msg.getPitchWheelValue();
-         double v = ( 2.0 * ( (double)pitchValue / (double)0x3fff ) ) - 1.0;
-         handlePitchbend( msg.getChannel(), v );
-      } else
-      if( msg.isController() )
-      {
-         // ccNum == 1 -> modwheel
-         int ccNum = msg.getControllerNumber();
-         // ccVal = 0..127
-         int ccVal = msg.getControllerValue();
-         double v = (double)ccVal / 127.0;
-         handleControllerChange( msg.getChannel(), ccNum, v );
-      }
-   }
-
-   midiMessages.clear();
+   // Streamed samples may wait for the disk while rendering offline
+   engine->setRealtime( !isNonRealtime() );
 
    juce::ScopedNoDenormals noDenormals;
    auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -406,12 +390,6 @@ void PluginProcessor::processBlock( juce::AudioBuffer<float>& buffer,
       buffer.clear (i, 0, buffer.getNumSamples());
    }
 
-   // This is the place where you'd normally do the guts of your plugin's
-   // audio processing...
-   // Make sure to reset the state if your inner loop is processing
-   // the samples and the outer loop is handling the channels.
-   // Alternatively, you can process the samples with the channels
-   // interleaved by keeping the same state.
    std::vector<SamplerEngine::OutputBus> buses;
    buses.resize( (size_t)getBusCount( false ) );
 
@@ -436,7 +414,55 @@ void PluginProcessor::processBlock( juce::AudioBuffer<float>& buffer,
       }
    }
 
-   if( m_pEngine->process( buses, m_sampleRate, bpm ) )
+   // The block is split at the MIDI events' timestamps, so that each event
+   // takes effect exactly at the sample it has been scheduled for.
+   bool update = false;
+   size_t numSamples = (size_t)buffer.getNumSamples();
+   size_t curSample = 0;
+
+   for (const juce::MidiMessageMetadata metadata : midiMessages)
+   {
+      size_t eventSample = (size_t)juce::jlimit( 0, (int)numSamples, metadata.samplePosition );
+      if( eventSample > curSample )
+      {
+         update = engine->process( buses, curSample, eventSample - curSample, m_sampleRate, bpm ) || update;
+         curSample = eventSample;
+      }
+
+      const juce::MidiMessage msg = metadata.getMessage();
+      if( msg.isNoteOn() )
+      {
+         noteOn( msg.getChannel(), msg.getNoteNumber(), msg.getVelocity() / 127.0f );
+      } else
+      if( msg.isNoteOff() )
+      {
+         noteOff( msg.getChannel(), msg.getNoteNumber(), msg.getVelocity() / 127.0f );
+      } else
+      if( msg.isPitchWheel() )
+      {
+         int pitchValue = msg.getPitchWheelValue();
+         double v = ( 2.0 * ( (double)pitchValue / (double)0x3fff ) ) - 1.0;
+         handlePitchbend( msg.getChannel(), v );
+      } else
+      if( msg.isController() )
+      {
+         // ccNum == 1 -> modwheel
+         int ccNum = msg.getControllerNumber();
+         // ccVal = 0..127
+         int ccVal = msg.getControllerValue();
+         double v = (double)ccVal / 127.0;
+         handleControllerChange( msg.getChannel(), ccNum, v );
+      }
+   }
+
+   midiMessages.clear();
+
+   if( curSample < numSamples )
+   {
+      update = engine->process( buses, curSample, numSamples - curSample, m_sampleRate, bpm ) || update;
+   }
+
+   if( update )
    {
       if( m_pEditor )
       {
@@ -483,8 +509,12 @@ void PluginProcessor::getStateInformation( juce::MemoryBlock& destData )
    // You should use this method to store your parameters in the memory block.
    // You could do that either as raw data, or use the XML or ValueTree classes
    // as intermediaries to make it easy to save and load complex data.
-   std::string xml = util::toString( m_pEngine->toXml() );
-   destData.replaceAll( xml.c_str(), xml.length() );
+   EngineSnapshot::Reader engine( m_Engine );
+   SamplerEngine::BinaryState state;
+   engine->saveState( state );
+
+   destData.setSize( state.size() );
+   state.write( destData.getData() );
 }
 
 
@@ -499,19 +529,11 @@ void PluginProcessor::setStateInformation( const void* data, int sizeInBytes )
 {
    // You should use this method to restore your parameters from this memory block,
    // whose contents will have been created by the getStateInformation() call.
-   xmlDocPtr doc = xmlReadMemory( (const char *)data, sizeInBytes, "noname.xml", nullptr, 0 );
-   if( doc != nullptr )
+   // States saved by older versions are plain XML, loadState() handles both.
+   SamplerEngine::Engine *pEngine = SamplerEngine::Engine::loadState( data, (size_t)sizeInBytes );
+   if( pEngine )
    {
-      xmlNode *pRoot = xmlDocGetRootElement( doc );
-      SamplerEngine::Engine *pEngine = SamplerEngine::Engine::fromXml( pRoot );
-      if( pEngine )
-      {
-         delete m_pEngine;
-         pEngine->setProcessor( this );
-         m_pEngine = pEngine;
-      }
-
-      xmlFreeDoc( doc );
+      swapEngine( pEngine );
    }
 }
 
@@ -537,7 +559,7 @@ This callback function get called when a specific sample shall be deleted.
 /*----------------------------------------------------------------------------*/
 void PluginProcessor::onDeleteSample( size_t part, SamplerEngine::Sample *pSample )
 {
-   m_pEngine->deleteSample( part, pSample );
+   samplerEngine()->deleteSample( part, pSample );
 }
 
 
@@ -554,17 +576,71 @@ void PluginProcessor::onSampleSelectionUpdated( SamplerGUI::UISectionSamplerKeyb
    {
       m_pEditor->onSampleSelectionUpdated( pKeyboard );
    }
+
+   publishSelection();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Pass the editor's solo state and sample selection on to the engine. Must be
+called whenever either of them changes.
+*/
+/*----------------------------------------------------------------------------*/
+void PluginProcessor::publishSelection()
+{
+   publishSelection( samplerEngine() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pEngine The engine to pass the editor's solo state and sample selection to
+*/
+/*----------------------------------------------------------------------------*/
+void PluginProcessor::publishSelection( SamplerEngine::Engine *pEngine )
+{
+   bool solo = false;
+   std::set<SamplerEngine::Sample *> selectedSamples;
+
+   if( m_pEditor )
+   {
+      solo = m_pEditor->isSoloEnabled();
+      selectedSamples = m_pEditor->getSelectedSamples();
+   }
+
+   pEngine->host().publishSelection( solo, selectedSamples );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Called by the editor's destructor (from juce::AudioProcessor). Without an
+editor, the solo function is off.
+\param pEditor The editor
+*/
+/*----------------------------------------------------------------------------*/
+void PluginProcessor::editorBeingDeleted( juce::AudioProcessorEditor *pEditor ) noexcept
+{
+   AudioProcessor::editorBeingDeleted( pEditor );
+
+   if( pEditor == m_pEditor )
+   {
+      m_pEditor = nullptr;
+      publishSelection();
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-10
-\return The Engine
+\return The Engine. Only to be used on the message thread, the audio thread
+accesses the engine through an EngineSnapshot::Reader.
 */
 /*----------------------------------------------------------------------------*/
 SamplerEngine::Engine *PluginProcessor::samplerEngine() const
 {
-   return( m_pEngine );
+   return( m_Engine.current() );
 }
 
 
@@ -588,8 +664,33 @@ void PluginProcessor::importMulti( xmlNode *pXmlMulti )
    SamplerEngine::Engine *pEngine = SamplerEngine::Engine::fromXml( pXmlMulti );
    if( pEngine )
    {
-      delete m_pEngine;
-      m_pEngine = pEngine;
+      swapEngine( pEngine );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Replace the engine by a new one, e.g. after loading a state. The new engine
+is published with an atomic pointer swap, so the audio thread picks it up
+at the next block boundary without ever having to wait. This function waits
+until the block that is currently being rendered with the old engine (if
+any) is finished, then the old engine is freed on a background thread.
+Must be called from the message thread.
+\param pEngine The new engine, ownership is taken over
+*/
+/*----------------------------------------------------------------------------*/
+void PluginProcessor::swapEngine( SamplerEngine::Engine *pEngine )
+{
+   pEngine->prepareToPlay( (size_t)m_samplesPerBlock );
+   publishSelection( pEngine );
+
+   m_EngineReclaimer.reclaim( m_Engine.exchange( pEngine ) );
+
+   // Show the new engine's part settings
+   if( m_pEditor )
+   {
+      m_pEditor->activatePart( m_pEditor->currentPart() );
    }
 }
 
@@ -34,6 +34,9 @@
 
 #include <SamplerEngine/Voice.h>
 #include <SamplerEngine/Part.h>
+#include <SamplerEngine/SamplerEngine.h>
+#include <SamplerEngine/Snapshot.h>
+#include <SamplerEngine/Reclaimer.h>
 
 #include <SamplerGUI/UIPageZones/UISectionSamplerKeyboard.h>
 
@@ -55,6 +58,7 @@ public:
 
    virtual void onDeleteSample( size_t part, SamplerEngine::Sample *pSample );
    virtual void onSampleSelectionUpdated( SamplerGUI::UISectionSamplerKeyboard *pKeyboard );
+   void publishSelection();
 
    //==============================================================================
    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -67,6 +71,7 @@ public:
 
    //==============================================================================
    juce::AudioProcessorEditor* createEditor() override;
+   void editorBeingDeleted( juce::AudioProcessorEditor *pEditor ) noexcept override;
    bool hasEditor() const override;
 
    //==============================================================================
@@ -101,12 +106,17 @@ public:
    PluginEditor *pluginEditor() const;
 
 private:
+   typedef SamplerEngine::Snapshot<SamplerEngine::Engine> EngineSnapshot;
+
    bool outputBusReady( juce::AudioBuffer<float>& buffer, int n ) const;
+   void swapEngine( SamplerEngine::Engine *pEngine );
+   void publishSelection( SamplerEngine::Engine *pEngine );
 
    //==============================================================================
    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR( PluginProcessor )
 
-   SamplerEngine::Engine *m_pEngine;
+   SamplerEngine::Reclaimer<SamplerEngine::Engine> m_EngineReclaimer;
+   EngineSnapshot m_Engine;
    PluginEditor *m_pEditor;
 
    double m_sampleRate;
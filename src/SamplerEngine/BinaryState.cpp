@@ -0,0 +1,474 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file BinaryState.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief The binary format of the engine's saved state
+*/
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+
+#ifdef SAMPLERENGINE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <util.h>
+
+#include "BinaryState.h"
+
+using namespace SamplerEngine;
+
+#define BINARYSTATE_FILEHEADERSIZE 24
+#define BINARYSTATE_CHUNKHEADERSIZE 32
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pDest Destination
+\param v The value to be stored in little endian byte order
+\param nBytes The number of bytes
+*/
+/*----------------------------------------------------------------------------*/
+static void putLE( uint8_t *pDest, uint64_t v, int nBytes )
+{
+   for( int i = 0; i < nBytes; i++ )
+   {
+      pDest[i] = (uint8_t)( v >> ( i * 8 ) );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pSrc Source
+\param nBytes The number of bytes
+\return The little endian value
+*/
+/*----------------------------------------------------------------------------*/
+static uint64_t getLE( const uint8_t *pSrc, int nBytes )
+{
+   uint64_t v = 0;
+   for( int i = nBytes - 1; i >= 0; i-- )
+   {
+      v = ( v << 8 ) | pSrc[i];
+   }
+   return( v );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param n Offset
+\return n rounded up to the chunk alignment
+*/
+/*----------------------------------------------------------------------------*/
+static size_t align( size_t n )
+{
+   return( ( n + BINARYSTATE_ALIGNMENT - 1 ) & ~(size_t)( BINARYSTATE_ALIGNMENT - 1 ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+BinaryState::BinaryState() :
+   m_Compression( CompressionNone ),
+   m_EmbedSamples( true )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+BinaryState::~BinaryState()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param compression The compression to be used for chunks added with
+addChunk(). Compressions not supported by this build are ignored.
+*/
+/*----------------------------------------------------------------------------*/
+void BinaryState::setCompression( Compression compression )
+{
+   if( allCompressions().count( compression ) > 0 )
+   {
+      m_Compression = compression;
+   } else
+   {
+      m_Compression = CompressionNone;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The compression used for chunks added with addChunk()
+*/
+/*----------------------------------------------------------------------------*/
+BinaryState::Compression BinaryState::getCompression() const
+{
+   return( m_Compression );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param embed If false, audio data which has been loaded from a file is
+referenced by its file name and hash instead of being stored in the state
+*/
+/*----------------------------------------------------------------------------*/
+void BinaryState::setEmbedSamples( bool embed )
+{
+   m_EmbedSamples = embed;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the audio data is stored in the state
+*/
+/*----------------------------------------------------------------------------*/
+bool BinaryState::getEmbedSamples() const
+{
+   return( m_EmbedSamples );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add a chunk of binary data. Without compression, the data isn't copied, so
+it must remain valid until write() has been called. Data which has been
+added already (e.g. audio data shared by several samples) is stored only
+once.
+\param pData The data
+\param size The data's size in bytes
+\return The chunk's number, to be stored in the XML
+*/
+/*----------------------------------------------------------------------------*/
+uint32_t BinaryState::addChunk( const uint8_t *pData, size_t size )
+{
+   auto existing = m_ChunksByData.find( pData );
+   if( existing != m_ChunksByData.end() && m_Chunks[existing->second].size == size )
+      return( existing->second );
+
+   Chunk chunk;
+   chunk.pData = pData;
+   chunk.storedSize = size;
+   chunk.size = size;
+   chunk.compression = CompressionNone;
+
+#ifdef SAMPLERENGINE_ZLIB
+   if( m_Compression == CompressionZlib && size > 0 )
+   {
+      uLongf compressedSize = compressBound( (uLong)size );
+      chunk.compressed.resize( compressedSize );
+      if( compress2( chunk.compressed.data(), &compressedSize, pData, (uLong)size, Z_BEST_SPEED ) == Z_OK &&
+          compressedSize < size )
+      {
+         chunk.compressed.resize( compressedSize );
+         chunk.pData = chunk.compressed.data();
+         chunk.storedSize = compressedSize;
+         chunk.compression = CompressionZlib;
+      } else
+      {
+         chunk.compressed.clear();
+      }
+   }
+#endif
+
+   m_Chunks.push_back( std::move( chunk ) );
+   m_ChunksByData[pData] = (uint32_t)( m_Chunks.size() - 1 );
+
+   return( (uint32_t)( m_Chunks.size() - 1 ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param xml The engine's settings
+*/
+/*----------------------------------------------------------------------------*/
+void BinaryState::setXml( const std::string &xml )
+{
+   m_Xml = xml;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The size of the file header, the chunk headers and the XML in bytes
+*/
+/*----------------------------------------------------------------------------*/
+size_t BinaryState::headerSize() const
+{
+   return( BINARYSTATE_FILEHEADERSIZE + ( m_Chunks.size() * BINARYSTATE_CHUNKHEADERSIZE ) + m_Xml.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The size of the state in bytes, as written by write()
+*/
+/*----------------------------------------------------------------------------*/
+size_t BinaryState::size() const
+{
+   size_t n = headerSize();
+   for( const Chunk &chunk : m_Chunks )
+   {
+      n = align( n ) + chunk.storedSize;
+   }
+
+   return( n );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Write the state.
+\param pDest Destination with at least size() bytes
+*/
+/*----------------------------------------------------------------------------*/
+void BinaryState::write( void *pDest ) const
+{
+   uint8_t *pD = (uint8_t *)pDest;
+
+   memcpy( pD, BINARYSTATE_MAGIC, 4 );
+   putLE( pD + 4, BINARYSTATE_VERSION, 4 );
+   putLE( pD + 8, m_Chunks.size(), 4 );
+   putLE( pD + 12, 0, 4 );
+   putLE( pD + 16, m_Xml.size(), 8 );
+
+   size_t offset = headerSize();
+   for( size_t i = 0; i < m_Chunks.size(); i++ )
+   {
+      const Chunk &chunk = m_Chunks[i];
+      uint8_t *pChunkHeader = pD + BINARYSTATE_FILEHEADERSIZE + ( i * BINARYSTATE_CHUNKHEADERSIZE );
+      size_t chunkOffset = align( offset );
+
+      putLE( pChunkHeader, chunkOffset, 8 );
+      putLE( pChunkHeader + 8, chunk.storedSize, 8 );
+      putLE( pChunkHeader + 16, chunk.size, 8 );
+      putLE( pChunkHeader + 24, chunk.compression, 4 );
+      putLE( pChunkHeader + 28, 0, 4 );
+
+      memset( pD + offset, 0, chunkOffset - offset );
+      memcpy( pD + chunkOffset, chunk.pData, chunk.storedSize );
+      offset = chunkOffset + chunk.storedSize;
+   }
+
+   memcpy( pD + BINARYSTATE_FILEHEADERSIZE + ( m_Chunks.size() * BINARYSTATE_CHUNKHEADERSIZE ), m_Xml.data(), m_Xml.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pData The saved state
+\param size The state's size in bytes
+\return true if the state is in the binary format (rather than plain XML)
+*/
+/*----------------------------------------------------------------------------*/
+bool BinaryState::isBinaryState( const void *pData, size_t size )
+{
+   return( size >= BINARYSTATE_FILEHEADERSIZE && memcmp( pData, BINARYSTATE_MAGIC, 4 ) == 0 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Parse a state written by write(). The chunks aren't copied, so the data must
+remain valid for as long as chunks are read.
+\param pData The saved state
+\param size The state's size in bytes
+\return true on success
+*/
+/*----------------------------------------------------------------------------*/
+bool BinaryState::read( const void *pData, size_t size )
+{
+   const uint8_t *pD = (const uint8_t *)pData;
+
+   m_Xml.clear();
+   m_Chunks.clear();
+   m_ChunksByData.clear();
+
+   if( !isBinaryState( pData, size ) )
+      return( false );
+
+   // Newer versions may add fields, but must keep this layout compatible
+   uint64_t version = getLE( pD + 4, 4 );
+   uint64_t numChunks = getLE( pD + 8, 4 );
+   uint64_t xmlSize = getLE( pD + 16, 8 );
+   if( version < 1 )
+      return( false );
+
+   if( numChunks > ( size - BINARYSTATE_FILEHEADERSIZE ) / BINARYSTATE_CHUNKHEADERSIZE )
+      return( false );
+
+   size_t xmlOffset = BINARYSTATE_FILEHEADERSIZE + ( numChunks * BINARYSTATE_CHUNKHEADERSIZE );
+   if( xmlSize > size - xmlOffset )
+      return( false );
+
+   for( size_t i = 0; i < numChunks; i++ )
+   {
+      const uint8_t *pChunkHeader = pD + BINARYSTATE_FILEHEADERSIZE + ( i * BINARYSTATE_CHUNKHEADERSIZE );
+      uint64_t offset = getLE( pChunkHeader, 8 );
+      uint64_t storedSize = getLE( pChunkHeader + 8, 8 );
+
+      if( offset > size || storedSize > size - offset )
+         return( false );
+
+      Chunk chunk;
+      chunk.pData = pD + offset;
+      chunk.storedSize = storedSize;
+      chunk.size = getLE( pChunkHeader + 16, 8 );
+      chunk.compression = (Compression)getLE( pChunkHeader + 24, 4 );
+      m_Chunks.push_back( std::move( chunk ) );
+   }
+
+   m_Xml = std::string( (const char *)pD + xmlOffset, xmlSize );
+
+   return( true );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The engine's settings
+*/
+/*----------------------------------------------------------------------------*/
+const std::string &BinaryState::xml() const
+{
+   return( m_Xml );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nChunk The chunk's number
+\return The chunk's uncompressed size in bytes or 0 if there is no such chunk
+*/
+/*----------------------------------------------------------------------------*/
+size_t BinaryState::chunkSize( uint32_t nChunk ) const
+{
+   if( nChunk >= m_Chunks.size() )
+      return( 0 );
+
+   return( m_Chunks[nChunk].size );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Read and decompress a chunk.
+\param nChunk The chunk's number
+\param pDest Destination
+\param size The size of the destination, must equal chunkSize()
+\return true on success
+*/
+/*----------------------------------------------------------------------------*/
+bool BinaryState::readChunk( uint32_t nChunk, uint8_t *pDest, size_t size ) const
+{
+   if( nChunk >= m_Chunks.size() )
+      return( false );
+
+   const Chunk &chunk = m_Chunks[nChunk];
+   if( size != chunk.size )
+      return( false );
+
+   if( chunk.compression == CompressionNone )
+   {
+      if( chunk.storedSize != chunk.size )
+         return( false );
+
+      memcpy( pDest, chunk.pData, size );
+      return( true );
+   }
+
+#ifdef SAMPLERENGINE_ZLIB
+   if( chunk.compression == CompressionZlib )
+   {
+      uLongf destSize = (uLongf)size;
+      return( uncompress( pDest, &destSize, chunk.pData, (uLong)chunk.storedSize ) == Z_OK && destSize == size );
+   }
+#endif
+
+   return( false );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param compression The compression
+\return The string representation of the compression
+*/
+/*----------------------------------------------------------------------------*/
+std::string BinaryState::toString( Compression compression )
+{
+   if( compression == CompressionZlib )
+   {
+      return( "Zlib" );
+   } else
+   {
+      return( "None" );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param compression The string representation of a compression
+\return The compression
+*/
+/*----------------------------------------------------------------------------*/
+BinaryState::Compression BinaryState::compressionFromString( const std::string &compression )
+{
+   if( util::trim( util::toLower( compression ) ) == "zlib" )
+   {
+      return( CompressionZlib );
+   } else
+   {
+      return( CompressionNone );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return All compressions supported by this build
+*/
+/*----------------------------------------------------------------------------*/
+std::set<BinaryState::Compression> BinaryState::allCompressions()
+{
+   std::set<Compression> compressions;
+   compressions.insert( CompressionNone );
+#ifdef SAMPLERENGINE_ZLIB
+   compressions.insert( CompressionZlib );
+#endif
+
+   return( compressions );
+}
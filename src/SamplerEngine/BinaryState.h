@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file BinaryState.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class BinaryState.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __BINARYSTATE_H__
+#define __BINARYSTATE_H__
+
+#include <stdint.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#define BINARYSTATE_MAGIC "OVVS"
+#define BINARYSTATE_VERSION 1
+#define BINARYSTATE_ALIGNMENT 16
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class BinaryState
+   \date  2026-10-17
+   The engine's saved state: the settings as XML plus the sample data as raw
+   binary chunks, which the XML refers to by number.
+
+   Layout (all numbers little endian):
+   - "OVVS", uint32 version, uint32 number of chunks, uint32 reserved,
+     uint64 XML size
+   - Per chunk: uint64 offset, uint64 stored size, uint64 size,
+     uint32 compression, uint32 reserved
+   - The XML (UTF-8, not null-terminated)
+   - The chunks' data, each aligned to BINARYSTATE_ALIGNMENT bytes
+   */
+   /*----------------------------------------------------------------------------*/
+   class BinaryState
+   {
+   public:
+      enum Compression
+      {
+         CompressionNone = 1,
+         CompressionZlib
+      };
+
+      BinaryState();
+      ~BinaryState();
+
+      void setCompression( Compression compression );
+      Compression getCompression() const;
+      void setEmbedSamples( bool embed );
+      bool getEmbedSamples() const;
+
+      uint32_t addChunk( const uint8_t *pData, size_t size );
+      void setXml( const std::string &xml );
+      size_t size() const;
+      void write( void *pDest ) const;
+
+      static bool isBinaryState( const void *pData, size_t size );
+      bool read( const void *pData, size_t size );
+      const std::string &xml() const;
+      size_t chunkSize( uint32_t nChunk ) const;
+      bool readChunk( uint32_t nChunk, uint8_t *pDest, size_t size ) const;
+
+      static std::string toString( Compression compression );
+      static Compression compressionFromString( const std::string &compression );
+      static std::set<Compression> allCompressions();
+
+   private:
+      BinaryState( const BinaryState & ) = delete;
+      BinaryState &operator=( const BinaryState & ) = delete;
+
+      struct Chunk
+      {
+         const uint8_t *pData;
+         size_t storedSize;
+         size_t size;
+         Compression compression;
+         std::vector<uint8_t> compressed;
+      };
+
+      size_t headerSize() const;
+
+   private:
+      Compression m_Compression;
+      bool m_EmbedSamples;
+      std::string m_Xml;
+      std::vector<Chunk> m_Chunks;
+      std::map<const uint8_t *, uint32_t> m_ChunksByData;
+   };
+}
+
+#endif
@@ -0,0 +1,436 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file DiskStreamer.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Streaming of audio data from disk
+*/
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+#include <algorithm>
+
+#include "DiskStreamer.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor. Copies the resident parts of a wave.
+\param pData The wave's audio data
+\param numSamples The number of frames of the wave
+\param frameSize The size of a frame in bytes
+\param numPreloadFrames The number of frames at the start and at the end of
+the wave and of its loop which are kept in memory
+\param loopStart The first frame of the loop
+\param loopEnd The last frame of the loop
+*/
+/*----------------------------------------------------------------------------*/
+StreamCache::StreamCache( const uint8_t *pData, uint32_t numSamples, size_t frameSize,
+                          uint32_t numPreloadFrames, uint32_t loopStart, uint32_t loopEnd ) :
+   m_pData( nullptr ),
+   m_Size( 0 ),
+   m_FrameSize( frameSize ),
+   m_Regions{},
+   m_NumRegions( 0 )
+{
+   const int64_t n = (int64_t)numSamples;
+   const int64_t nPreload = std::min( (int64_t)numPreloadFrames, n );
+
+   if( nPreload * 2 >= n )
+   {
+      // Short waves are kept in memory completely
+      m_Regions[m_NumRegions++] = { 0, n, nullptr };
+   } else
+   {
+      m_Regions[m_NumRegions++] = { 0, nPreload, nullptr };
+      m_Regions[m_NumRegions++] = { n - nPreload, n, nullptr };
+
+      // The loop's head and tail bridge the time the DiskStream needs to
+      // follow a jump at the loop points, plus the frames around them which
+      // the interpolation reads. Whether the wave is actually played looped
+      // depends on the sample, so any loop is kept.
+      if( loopEnd > loopStart )
+      {
+         const int64_t headEnd = std::min( (int64_t)loopStart + nPreload, (int64_t)loopEnd + 1 );
+         const int64_t tailFirst = std::max( (int64_t)loopEnd + 1 - nPreload, (int64_t)loopStart );
+
+         if( tailFirst <= headEnd )
+         {
+            addRegion( (int64_t)loopStart - SAMPLEREADER_SINCTAPS, (int64_t)loopEnd + 1 + SAMPLEREADER_SINCTAPS, nPreload, n );
+         } else
+         {
+            addRegion( (int64_t)loopStart - SAMPLEREADER_SINCTAPS, headEnd, nPreload, n );
+            addRegion( tailFirst, (int64_t)loopEnd + 1 + SAMPLEREADER_SINCTAPS, nPreload, n );
+         }
+      }
+   }
+
+   for( size_t r = 0; r < m_NumRegions; r++ )
+   {
+      m_Size += (size_t)( m_Regions[r].end - m_Regions[r].first ) * m_FrameSize;
+   }
+
+   m_pData = new uint8_t[m_Size];
+
+   size_t ofs = 0;
+   for( size_t r = 0; r < m_NumRegions; r++ )
+   {
+      size_t regionSize = (size_t)( m_Regions[r].end - m_Regions[r].first ) * m_FrameSize;
+      memcpy( m_pData + ofs, pData + ( (size_t)m_Regions[r].first * m_FrameSize ), regionSize );
+      m_Regions[r].pData = m_pData + ofs;
+      ofs += regionSize;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add a region of frames between the wave's head and tail, which are resident
+already.
+\param first The first frame of the region
+\param end The frame behind the region
+\param nPreload The number of frames of the head and the tail
+\param numSamples The number of frames of the wave
+*/
+/*----------------------------------------------------------------------------*/
+void StreamCache::addRegion( int64_t first, int64_t end, int64_t nPreload, int64_t numSamples )
+{
+   first = std::max( first, nPreload );
+   end = std::min( end, numSamples - nPreload );
+
+   if( first < end && m_NumRegions < STREAMCACHE_MAXREGIONS )
+   {
+      m_Regions[m_NumRegions++] = { first, end, nullptr };
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+StreamCache::~StreamCache()
+{
+   delete[] m_pData;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The size of the resident audio data in bytes
+*/
+/*----------------------------------------------------------------------------*/
+size_t StreamCache::size() const
+{
+   return( m_Size );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+DiskStream::DiskStream() :
+   m_State( StateFree ),
+   m_FrameSize( 0 ),
+   m_NumSamples( 0 ),
+   m_pRing( nullptr ),
+   m_Position( 0 ),
+   m_Reverse( false )
+{
+   for( size_t i = 0; i < DISKSTREAMER_NUMBLOCKS; i++ )
+   {
+      m_Blocks[i].store( -1 );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Publish the voice's read position, which the I/O thread loads ahead of.
+Only called by the voice owning the stream.
+\param position The frame the voice reads next
+\param reverse true if the voice plays backwards
+\return true if the position has moved to another block, so that the I/O
+thread should be woken up
+*/
+/*----------------------------------------------------------------------------*/
+bool DiskStream::setPosition( double position, bool reverse )
+{
+   int64_t pos = position < 0.0 ? 0 : (int64_t)position;
+   int64_t prevPos = m_Position.exchange( pos, std::memory_order_relaxed );
+   bool prevReverse = m_Reverse.exchange( reverse, std::memory_order_relaxed );
+
+   return( ( prevPos / DISKSTREAMER_BLOCKFRAMES ) != ( pos / DISKSTREAMER_BLOCKFRAMES ) || prevReverse != reverse );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor. Allocates the ring buffers of all streams and starts the I/O
+thread.
+*/
+/*----------------------------------------------------------------------------*/
+DiskStreamer::DiskStreamer() :
+   m_pStreams( new DiskStream[DISKSTREAMER_NUMSTREAMS] ),
+   m_pRings( nullptr ),
+   m_Wakeup( 0 ),
+   m_NumUnderruns( 0 ),
+   m_Quit( false )
+{
+   const size_t ringSize = DISKSTREAMER_NUMBLOCKS * DISKSTREAMER_BLOCKFRAMES * DISKSTREAMER_MAXFRAMESIZE;
+
+   m_pRings = new uint8_t[DISKSTREAMER_NUMSTREAMS * ringSize];
+   for( size_t i = 0; i < DISKSTREAMER_NUMSTREAMS; i++ )
+   {
+      m_pStreams[i].m_pRing = m_pRings + ( i * ringSize );
+   }
+
+   m_Thread = std::thread( &DiskStreamer::run, this );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor. Stops the I/O thread.
+*/
+/*----------------------------------------------------------------------------*/
+DiskStreamer::~DiskStreamer()
+{
+   m_Quit.store( true );
+   wakeUp();
+   m_Thread.join();
+
+   delete[] m_pRings;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The process-wide disk streamer
+*/
+/*----------------------------------------------------------------------------*/
+DiskStreamer &DiskStreamer::instance()
+{
+   static DiskStreamer streamer;
+
+   return( streamer );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Take an unused stream and start filling it. Called by a voice on the audio
+thread.
+\param pData The wave's audio data, which is kept alive until the stream has
+been released
+\param frameSize The size of a frame in bytes
+\param numSamples The number of frames of the wave
+\param position The frame the voice starts at
+\param reverse true if the voice plays backwards
+\return The stream or nullptr if all streams are in use
+*/
+/*----------------------------------------------------------------------------*/
+DiskStream *DiskStreamer::acquire( const std::shared_ptr<const WavePool::Data> &pData, size_t frameSize, uint32_t numSamples, double position, bool reverse )
+{
+   if( !pData || frameSize == 0 || frameSize > DISKSTREAMER_MAXFRAMESIZE )
+      return( nullptr );
+
+   for( size_t i = 0; i < DISKSTREAMER_NUMSTREAMS; i++ )
+   {
+      DiskStream &stream = m_pStreams[i];
+      int state = DiskStream::StateFree;
+
+      if( stream.m_State.compare_exchange_strong( state, DiskStream::StateSetup, std::memory_order_acquire ) )
+      {
+         stream.m_pData = pData;
+         stream.m_FrameSize = frameSize;
+         stream.m_NumSamples = numSamples;
+         for( size_t b = 0; b < DISKSTREAMER_NUMBLOCKS; b++ )
+         {
+            stream.m_Blocks[b].store( -1, std::memory_order_relaxed );
+         }
+         stream.setPosition( position, reverse );
+         stream.m_State.store( DiskStream::StateActive, std::memory_order_release );
+
+         wakeUp();
+         return( &stream );
+      }
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Hand a stream back. The I/O thread drops its reference to the audio data
+and makes it available again.
+\param pStream The stream, which must have been retrieved by acquire()
+*/
+/*----------------------------------------------------------------------------*/
+void DiskStreamer::release( DiskStream *pStream )
+{
+   if( !pStream )
+      return;
+
+   pStream->m_State.store( DiskStream::StateReleased, std::memory_order_release );
+   wakeUp();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Wake up the I/O thread, e.g. after a read position has changed.
+*/
+/*----------------------------------------------------------------------------*/
+void DiskStreamer::wakeUp()
+{
+   m_Wakeup.fetch_add( 1, std::memory_order_release );
+   m_Wakeup.notify_one();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Count a block in which a voice had to play frames which weren't loaded.
+*/
+/*----------------------------------------------------------------------------*/
+void DiskStreamer::countUnderrun()
+{
+   m_NumUnderruns.fetch_add( 1, std::memory_order_relaxed );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of blocks in which voices have played frames which
+weren't loaded in time, since the start of the process
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t DiskStreamer::numUnderruns() const
+{
+   return( m_NumUnderruns.load( std::memory_order_relaxed ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of streams in use
+*/
+/*----------------------------------------------------------------------------*/
+size_t DiskStreamer::numActiveStreams() const
+{
+   size_t n = 0;
+   for( size_t i = 0; i < DISKSTREAMER_NUMSTREAMS; i++ )
+   {
+      if( m_pStreams[i].m_State.load( std::memory_order_relaxed ) != DiskStream::StateFree )
+      {
+         n++;
+      }
+   }
+
+   return( n );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+The I/O thread. It loads one block per stream and pass, so that all streams
+progress evenly, and sleeps when all streams are filled.
+*/
+/*----------------------------------------------------------------------------*/
+void DiskStreamer::run()
+{
+   while( !m_Quit.load() )
+   {
+      uint32_t wakeup = m_Wakeup.load( std::memory_order_acquire );
+      bool busy = false;
+
+      for( size_t i = 0; i < DISKSTREAMER_NUMSTREAMS; i++ )
+      {
+         DiskStream &stream = m_pStreams[i];
+         int state = stream.m_State.load( std::memory_order_acquire );
+
+         if( state == DiskStream::StateReleased )
+         {
+            // Freeing the audio data may unmap the file, which must not
+            // happen on the audio thread
+            stream.m_pData.reset();
+            stream.m_State.store( DiskStream::StateFree, std::memory_order_release );
+         } else
+         if( state == DiskStream::StateActive )
+         {
+            busy = fill( stream ) || busy;
+         }
+      }
+
+      if( !busy )
+      {
+         m_Wakeup.wait( wakeup, std::memory_order_acquire );
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Load the next missing block ahead of a stream's read position. The block
+behind the read position is kept, since the interpolation still reads it,
+so DISKSTREAMER_NUMBLOCKS - 1 blocks are loaded ahead.
+\param stream The stream
+\return true if a block has been loaded
+*/
+/*----------------------------------------------------------------------------*/
+bool DiskStreamer::fill( DiskStream &stream )
+{
+   const int64_t nFirst = stream.m_Position.load( std::memory_order_relaxed ) / DISKSTREAMER_BLOCKFRAMES;
+   const bool reverse = stream.m_Reverse.load( std::memory_order_relaxed );
+   const int64_t numSamples = (int64_t)stream.m_NumSamples;
+
+   for( int64_t k = 0; k < DISKSTREAMER_NUMBLOCKS - 1; k++ )
+   {
+      const int64_t nBlock = reverse ? nFirst - k : nFirst + k;
+      const int64_t first = nBlock * DISKSTREAMER_BLOCKFRAMES;
+      if( nBlock < 0 || first >= numSamples )
+         break;
+
+      std::atomic<int64_t> &tag = stream.m_Blocks[(size_t)nBlock % DISKSTREAMER_NUMBLOCKS];
+      if( tag.load( std::memory_order_relaxed ) == nBlock )
+         continue;
+
+      // Invalidate the slot before overwriting it
+      tag.store( -1, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+
+      const size_t n = (size_t)std::min( (int64_t)DISKSTREAMER_BLOCKFRAMES, numSamples - first );
+      uint8_t *pSlot = stream.m_pRing + ( ( (size_t)nBlock % DISKSTREAMER_NUMBLOCKS ) * DISKSTREAMER_BLOCKFRAMES * stream.m_FrameSize );
+      memcpy( pSlot, stream.m_pData->data() + ( (size_t)first * stream.m_FrameSize ), n * stream.m_FrameSize );
+
+      tag.store( nBlock, std::memory_order_release );
+      return( true );
+   }
+
+   return( false );
+}
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file DiskStreamer.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class DiskStreamer.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __DISKSTREAMER_H__
+#define __DISKSTREAMER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "SampleReader.h"
+#include "WavePool.h"
+
+#define DISKSTREAMER_NUMSTREAMS 128
+#define DISKSTREAMER_BLOCKFRAMES 4096
+#define DISKSTREAMER_NUMBLOCKS 4
+#define DISKSTREAMER_MAXFRAMESIZE 16
+#define STREAMCACHE_MAXREGIONS 4
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class StreamCache
+   \date  2026-10-17
+   The resident parts of a streamed wave: its head, its tail (for reverse
+   playback) and the head and tail of its loop. Voices read these from memory, everything else
+   comes from their DiskStream. Immutable once created.
+   */
+   /*----------------------------------------------------------------------------*/
+   class StreamCache
+   {
+   public:
+      StreamCache( const uint8_t *pData, uint32_t numSamples, size_t frameSize,
+                   uint32_t numPreloadFrames, uint32_t loopStart, uint32_t loopEnd );
+      ~StreamCache();
+
+      size_t size() const;
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      \param i The frame number
+      \return Pointer to the frame or nullptr if it isn't resident
+      */
+      /*----------------------------------------------------------------------------*/
+      inline const uint8_t *frame( int64_t i ) const
+      {
+         for( size_t r = 0; r < m_NumRegions; r++ )
+         {
+            if( i >= m_Regions[r].first && i < m_Regions[r].end )
+               return( m_Regions[r].pData + ( (size_t)( i - m_Regions[r].first ) * m_FrameSize ) );
+         }
+
+         return( nullptr );
+      }
+
+   private:
+      StreamCache( const StreamCache & ) = delete;
+      StreamCache &operator=( const StreamCache & ) = delete;
+
+      void addRegion( int64_t first, int64_t end, int64_t nPreload, int64_t numSamples );
+
+      struct Region
+      {
+         int64_t first;
+         int64_t end;
+         const uint8_t *pData;
+      };
+
+      uint8_t *m_pData;
+      size_t m_Size;
+      size_t m_FrameSize;
+      Region m_Regions[STREAMCACHE_MAXREGIONS];
+      size_t m_NumRegions;
+   };
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class DiskStream
+   \date  2026-10-17
+   The ring buffer of one streaming voice. It holds DISKSTREAMER_NUMBLOCKS
+   blocks of DISKSTREAMER_BLOCKFRAMES frames, each tagged with the number of
+   the block of the wave it contains. The DiskStreamer's I/O thread keeps the
+   blocks ahead of the published read position filled, the voice reads them
+   without ever waiting.
+   */
+   /*----------------------------------------------------------------------------*/
+   class DiskStream
+   {
+      friend class DiskStreamer;
+
+   public:
+      DiskStream();
+
+      bool setPosition( double position, bool reverse );
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      \param i The frame number
+      \return Pointer to the frame or nullptr if it hasn't been loaded (yet)
+      */
+      /*----------------------------------------------------------------------------*/
+      inline const uint8_t *frame( int64_t i ) const
+      {
+         const int64_t nBlock = i / DISKSTREAMER_BLOCKFRAMES;
+         const size_t nSlot = (size_t)nBlock % DISKSTREAMER_NUMBLOCKS;
+
+         if( m_Blocks[nSlot].load( std::memory_order_acquire ) != nBlock )
+            return( nullptr );
+
+         return( m_pRing + ( ( ( nSlot * DISKSTREAMER_BLOCKFRAMES ) + (size_t)( i % DISKSTREAMER_BLOCKFRAMES ) ) * m_FrameSize ) );
+      }
+
+   private:
+      DiskStream( const DiskStream & ) = delete;
+      DiskStream &operator=( const DiskStream & ) = delete;
+
+      enum State
+      {
+         StateFree = 1,
+         StateSetup,
+         StateActive,
+         StateReleased
+      };
+
+      std::atomic<int> m_State;
+      std::shared_ptr<const WavePool::Data> m_pData;
+      size_t m_FrameSize;
+      uint32_t m_NumSamples;
+      uint8_t *m_pRing;
+      std::atomic<int64_t> m_Blocks[DISKSTREAMER_NUMBLOCKS];
+      std::atomic<int64_t> m_Position;
+      std::atomic<bool> m_Reverse;
+   };
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class DiskStreamer
+   \date  2026-10-17
+   Streams the audio data of waves loaded with WaveFile::LoadModeStream from
+   disk. A fixed number of DiskStream objects is preallocated for the whole
+   process, and a single I/O thread fills them. Acquiring, releasing and
+   reading streams neither blocks nor allocates memory, so it's done on the
+   audio thread. Frames which aren't resident or loaded in time are played
+   as silence and counted as underruns.
+   */
+   /*----------------------------------------------------------------------------*/
+   class DiskStreamer
+   {
+   public:
+      static DiskStreamer &instance();
+
+      DiskStream *acquire( const std::shared_ptr<const WavePool::Data> &pData, size_t frameSize, uint32_t numSamples, double position, bool reverse );
+      void release( DiskStream *pStream );
+      void wakeUp();
+      void countUnderrun();
+
+      uint64_t numUnderruns() const;
+      size_t numActiveStreams() const;
+
+   private:
+      DiskStreamer();
+      ~DiskStreamer();
+      DiskStreamer( const DiskStreamer & ) = delete;
+      DiskStreamer &operator=( const DiskStreamer & ) = delete;
+
+      void run();
+      bool fill( DiskStream &stream );
+
+   private:
+      std::unique_ptr<DiskStream[]> m_pStreams;
+      uint8_t *m_pRings;
+      std::atomic<uint32_t> m_Wakeup;
+      std::atomic<uint64_t> m_NumUnderruns;
+      std::atomic<bool> m_Quit;
+      std::thread m_Thread;
+   };
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class StreamFrames
+   \date  2026-10-17
+   \brief Access to the frames of a streamed wave for SampleReader::block().
+   Frames are taken from the StreamCache or the voice's DiskStream. Frames
+   which are in neither are read as silence. Indices outside the wave are
+   clamped to its first or last frame.
+   */
+   /*----------------------------------------------------------------------------*/
+   template<int FORMAT, int NCHANNELS>
+   class StreamFrames
+   {
+   public:
+      StreamFrames( const StreamCache *pCache, const DiskStream *pStream, uint32_t numSamples ) :
+         m_pCache( pCache ),
+         m_pStream( pStream ),
+         m_Last( (int64_t)numSamples - 1 ),
+         m_IsComplete( true )
+      {
+      }
+
+      inline int64_t last() const
+      {
+         return( m_Last );
+      }
+
+      inline bool isComplete() const
+      {
+         return( m_IsComplete );
+      }
+
+      inline void get( int64_t i, float &l, float &r ) const
+      {
+         i = i < 0 ? 0 : ( i > m_Last ? m_Last : i );
+
+         const uint8_t *p = m_pCache ? m_pCache->frame( i ) : nullptr;
+         if( !p && m_pStream )
+         {
+            p = m_pStream->frame( i );
+         }
+
+         if( !p )
+         {
+            l = r = 0.0f;
+            m_IsComplete = false;
+            return;
+         }
+
+         l = SampleReader::decode<FORMAT>( p );
+         r = NCHANNELS == 1 ? l : SampleReader::decode<FORMAT>( p + SampleReader::bytesPerSample<FORMAT>() );
+      }
+
+      inline void sinc( int64_t i, const float *pCoeffs, float &l, float &r ) const
+      {
+         alignas( 16 ) float tapsL[SAMPLEREADER_SINCTAPS];
+         alignas( 16 ) float tapsR[SAMPLEREADER_SINCTAPS];
+         const int64_t i0 = i - ( SAMPLEREADER_SINCTAPS / 2 ) + 1;
+
+         for( int k = 0; k < SAMPLEREADER_SINCTAPS; k++ )
+         {
+            get( i0 + k, tapsL[k], tapsR[k] );
+         }
+
+         l = SampleReader::dot( tapsL, pCoeffs );
+         r = NCHANNELS == 1 ? l : SampleReader::dot( tapsR, pCoeffs );
+      }
+
+   private:
+      const StreamCache *m_pCache;
+      const DiskStream *m_pStream;
+      int64_t m_Last;
+      mutable bool m_IsComplete;
+   };
+}
+
+#endif
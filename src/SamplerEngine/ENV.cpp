@@ -241,6 +241,18 @@ void ENV::step( double s, double /*bpm*/ )
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Reset the envelope's state, so that the ENV object can be reused for a new note.
+*/
+/*----------------------------------------------------------------------------*/
+void ENV::reset()
+{
+   m_Value = 0.0;
+   m_State = StateNone;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-10
 */
@@ -74,6 +74,7 @@ namespace SamplerEngine
       static double paramToDuration( double p );
 
 
+      void reset();
       void noteOn();
       void noteOff();
 
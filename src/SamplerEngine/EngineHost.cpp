@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file EngineHost.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class holds the state the host provides to the engine
+*/
+/*----------------------------------------------------------------------------*/
+#include "EngineHost.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+EngineHost::EngineHost() :
+   m_Selection( new Selection( { false, std::set<const Sample *>() } ) ),
+   m_NumUnderruns( 0 )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+EngineHost::~EngineHost()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Publish the solo state and the samples selected by the user. Must not be
+called from the audio thread, as it allocates and may wait for the audio
+thread to finish reading the previous selection.
+\param solo true if only the selected samples shall be played
+\param samples The selected samples
+*/
+/*----------------------------------------------------------------------------*/
+void EngineHost::publishSelection( bool solo, const std::set<Sample *> &samples )
+{
+   m_Selection.publish( new Selection( { solo, std::set<const Sample *>( samples.begin(), samples.end() ) } ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The current solo state and sample selection
+*/
+/*----------------------------------------------------------------------------*/
+const Snapshot<const EngineHost::Selection> &EngineHost::selection() const
+{
+   return( m_Selection );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param selection A solo state and sample selection
+\param pSample A sample
+\return true if the sample may be played
+*/
+/*----------------------------------------------------------------------------*/
+bool EngineHost::isAudible( const Selection &selection, const Sample *pSample )
+{
+   return( !selection.solo || selection.samples.find( pSample ) != selection.samples.end() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Count a block in which a voice of the engine had to play frames of a streamed
+wave which weren't loaded in time. Called from the audio thread.
+*/
+/*----------------------------------------------------------------------------*/
+void EngineHost::countUnderrun()
+{
+   m_NumUnderruns.fetch_add( 1, std::memory_order_relaxed );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of blocks in which the engine's voices have played frames
+which weren't loaded in time
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t EngineHost::numUnderruns() const
+{
+   return( m_NumUnderruns.load( std::memory_order_relaxed ) );
+}
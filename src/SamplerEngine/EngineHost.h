@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file EngineHost.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class EngineHost.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __ENGINEHOST_H__
+#define __ENGINEHOST_H__
+
+#include <atomic>
+#include <set>
+
+#include "Snapshot.h"
+
+//==============================================================================
+namespace SamplerEngine
+{
+   class Sample;
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class EngineHost
+   \date  2026-10-17
+   The state the host (e.g. the plugin's editor) provides to the engine. The
+   host publishes it from its own thread, the engine reads it lock-free from
+   the audio thread. In turn, the engine reports its disk streaming underruns
+   here for the host to display.
+   */
+   /*----------------------------------------------------------------------------*/
+   class EngineHost
+   {
+   public:
+      struct Selection
+      {
+         bool solo;
+         std::set<const Sample *> samples;
+      };
+
+      EngineHost();
+      ~EngineHost();
+
+      void publishSelection( bool solo, const std::set<Sample *> &samples );
+      const Snapshot<const Selection> &selection() const;
+
+      static bool isAudible( const Selection &selection, const Sample *pSample );
+
+      void countUnderrun();
+      uint64_t numUnderruns() const;
+
+   private:
+      EngineHost( const EngineHost & ) = delete;
+      EngineHost &operator=( const EngineHost & ) = delete;
+
+      Snapshot<const Selection> m_Selection;
+      std::atomic<uint64_t> m_NumUnderruns;
+   };
+}
+
+#endif
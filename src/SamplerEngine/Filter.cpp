@@ -28,6 +28,14 @@
 #include <math.h>
 #include <util.h>
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define FILTER_SSE2
+#include <emmintrin.h>
+#elif defined( __aarch64__ ) && defined( __ARM_NEON )
+#define FILTER_NEON
+#include <arm_neon.h>
+#endif
+
 #include "Filter.h"
 
 using namespace SamplerEngine;
@@ -44,6 +52,7 @@ Filter::Filter( const Filter &d )
    m_Type = d.m_Type;
    m_CutoffMod = d.m_CutoffMod;
    m_ResonanceMod = d.m_ResonanceMod;
+   m_HasCoeffs = false;
 
    for( int c = 0; c < 2; c++ )
    {
@@ -66,7 +75,8 @@ Filter::Filter() :
    m_CutoffMod( 0.0 ),
    m_Cutoff( 1.0 ),
    m_Resonance( 0.0 ),
-   m_ResonanceMod( 0.0 )
+   m_ResonanceMod( 0.0 ),
+   m_HasCoeffs( false )
 {
    for( int c = 0; c < 2; c++ )
    {
@@ -103,6 +113,29 @@ void Filter::getSettings( const Filter &d )
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Clear the filter's state and modulations, so that the Filter object can be
+reused for a new note.
+*/
+/*----------------------------------------------------------------------------*/
+void Filter::reset()
+{
+   m_CutoffMod = 0.0;
+   m_ResonanceMod = 0.0;
+   m_HasCoeffs = false;
+
+   for( int c = 0; c < 2; c++ )
+   {
+      for( int n = 0; n < 2; n++ )
+      {
+         m_X[c][n] = 0.0;
+         m_Y[c][n] = 0.0;
+      }
+   }
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-11
 \param type The new filter type
@@ -244,34 +277,63 @@ xmlNode *Filter::toXml() const
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-11
-Apply the filter to audio data.
-\param pLSamples Left audio channel
-\param lRSamples Right audio channel
-\param n Number of samples
-\param sampleRate Sample rate in Hz
+/*! 2026-10-17
+Approximation of tan( x ) by its [5/4] Padé approximant. The relative error
+is below 1e-5 up to x = 1.2, which covers cutoff frequencies up to ~0.38
+times the sample rate.
+\param x The angle (0..pi/2)
+\return tan( x )
+*/
+/*----------------------------------------------------------------------------*/
+double Filter::fastTan( double x )
+{
+   const double x2 = x * x;
+   return( x * ( 945.0 - ( 105.0 * x2 ) + ( x2 * x2 ) ) /
+               ( 945.0 - ( 420.0 * x2 ) + ( 15.0 * x2 * x2 ) ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Approximation of pow( 2.0, x ) with a relative error below 1e-7.
+\param x The exponent
+\return 2^x
+*/
+/*----------------------------------------------------------------------------*/
+double Filter::fastExp2( double x )
+{
+   const double i = floor( x );
+   const double f = x - i;
+
+   // Taylor series of 2^f = e^( f * ln2 ) on 0..1
+   const double t = f * M_LN2;
+   const double p = 1.0 + t * ( 1.0 + t * ( 1.0 / 2.0 + t * ( 1.0 / 6.0 + t * ( 1.0 / 24.0 + t * ( 1.0 / 120.0 +
+                    t * ( 1.0 / 720.0 + t * ( 1.0 / 5040.0 + t * ( 1.0 / 40320.0 ) ) ) ) ) ) ) );
+
+   return( ldexp( p, (int)i ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Calculate the biquad coefficients for a set of filter parameters. No
+transcendental functions are evaluated.
 \param type Filter type
 \param cutoff Cutoff frequency (0..1)
 \param resonance Resonance (0..1)
+\param sampleRate Sample rate in Hz
+\return The coefficients
 */
 /*----------------------------------------------------------------------------*/
-void Filter::process( float *pLSamples, float *pRSamples,
-                      const uint32_t n, double sampleRate,
-                      Type type, double cutoff, double resonance,
-                      double *pXL, double *pXR, double *pYL, double *pYR )
+Filter::Coefficients Filter::coefficients( Type type, double cutoff, double resonance, double sampleRate )
 {
-   std::vector<float *> samples( { pLSamples, pRSamples } );
-   std::vector<double *> X( { pXL, pXR } );
-   std::vector<double *> Y( { pYL, pYR } );
-
-   double a1 = 1.0;
-   double a2 = 0.0;
-   double a3 = 0.0;
-   double b1 = 0.0;
-   double b2 = 0.0;
+   Coefficients c = { 1.0, 0.0, 0.0, 0.0, 0.0 };
 
    double f = 1.0 + ( cutoff * ( 16000.0 - 1.0 ) );
-   double r = ( ( sqrt( 2.0 ) - 0.1 ) * ( 1.0 - resonance ) ) + 0.1;
+   double r = ( ( M_SQRT2 - 0.1 ) * ( 1.0 - resonance ) ) + 0.1;
+
+   // keep the angle below pi/2, where tan() has its pole
+   double w = util::clamp( 0.0, 0.49 * M_PI, M_PI * f / sampleRate );
 
    if( type == TYPE_LOWPASS )
    {
@@ -283,13 +345,13 @@ void Filter::process( float *pLSamples, float *pRSamples,
       // b1 = 2.0 * ( 1.0 - c * c ) * a1;
       // b2 = ( 1.0 - r * c + c * c ) * a1;
 
-      double c = 1.0 / tan( M_PI * f / sampleRate );
+      double k = 1.0 / fastTan( w );
 
-      a1 = 1.0 / ( 1.0 + ( r * c ) + ( c * c ) );
-      a2 = 2.0 * a1;
-      a3 = a1;
-      b1 = 2.0 * ( 1.0 - ( c * c ) ) * a1;
-      b2 = ( 1.0 - ( r * c ) + ( c * c ) ) * a1;
+      c.a1 = 1.0 / ( 1.0 + ( r * k ) + ( k * k ) );
+      c.a2 = 2.0 * c.a1;
+      c.a3 = c.a1;
+      c.b1 = 2.0 * ( 1.0 - ( k * k ) ) * c.a1;
+      c.b2 = ( 1.0 - ( r * k ) + ( k * k ) ) * c.a1;
    } else
    if( type == TYPE_HIGHPASS )
    {
@@ -301,38 +363,250 @@ void Filter::process( float *pLSamples, float *pRSamples,
       // b1 = 2.0 * ( c * c - 1.0 ) * a1;
       // b2 = ( 1.0 - r * c + c * c ) * a1;
 
-      double c = tan( M_PI * f / sampleRate );
+      double k = fastTan( w );
+
+      c.a1 = 1.0 / ( 1.0 + ( r * k ) + ( k * k ) );
+      c.a2 = -2.0 * c.a1;
+      c.a3 = c.a1;
+      c.b1 = 2.0 * ( ( k * k ) - 1.0 ) * c.a1;
+      c.b2 = ( 1.0 - ( r * k ) + ( k * k ) ) * c.a1;
+   }
+
+   return( c );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2024-06-11
+Apply the filter to audio data.
+\param pLSamples Left audio channel
+\param pRSamples Right audio channel
+\param n Number of samples
+\param sampleRate Sample rate in Hz
+\param type Filter type
+\param cutoff Cutoff frequency (0..1)
+\param resonance Resonance (0..1)
+\param pXL The left channel's input history (x[n-1], x[n-2])
+\param pXR The right channel's input history
+\param pYL The left channel's output history (y[n-1], y[n-2])
+\param pYR The right channel's output history
+*/
+/*----------------------------------------------------------------------------*/
+void Filter::process( float *pLSamples, float *pRSamples,
+                      const uint32_t n, double sampleRate,
+                      Type type, double cutoff, double resonance,
+                      double *pXL, double *pXR, double *pYL, double *pYR )
+{
+   if( type == TYPE_NONE )
+   {
+      passThrough( pLSamples, pRSamples, n, pXL, pXR, pYL, pYR );
+   } else
+   {
+      Coefficients c = coefficients( type, cutoff, resonance, sampleRate );
+      processBiquad( pLSamples, pRSamples, n, c, c, pXL, pXR, pYL, pYR );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Leave the audio data unchanged, but keep the filter's history up to date for
+when it gets enabled.
+*/
+/*----------------------------------------------------------------------------*/
+void Filter::passThrough( const float *pLSamples, const float *pRSamples,
+                          const uint32_t n,
+                          double *pXL, double *pXR, double *pYL, double *pYR )
+{
+   if( n >= 2 )
+   {
+      pXL[1] = pYL[1] = pLSamples[n - 2];
+      pXR[1] = pYR[1] = pRSamples[n - 2];
+   } else
+   if( n == 1 )
+   {
+      pXL[1] = pYL[1] = pXL[0];
+      pXR[1] = pYR[1] = pXR[0];
+   }
+   if( n >= 1 )
+   {
+      pXL[0] = pYL[0] = pLSamples[n - 1];
+      pXR[0] = pYR[0] = pRSamples[n - 1];
+   }
+}
+
 
-      a1 = 1.0 / ( 1.0 + ( r * c ) + ( c * c ) );
-      a2 = -2.0 * a1;
-      a3 = a1;
-      b1 = 2.0 * ( ( c * c ) - 1.0 ) * a1;
-      b2 = ( 1.0 - ( r * c ) + ( c * c ) ) * a1;
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Run the biquad over audio data while moving its coefficients linearly from
+one set to another, reaching the target set with the last sample.
+\param pLSamples Left audio channel
+\param pRSamples Right audio channel
+\param n Number of samples
+\param from The coefficients in effect before the first sample
+\param to The coefficients for the last sample
+\param pXL The left channel's input history (x[n-1], x[n-2])
+\param pXR The right channel's input history
+\param pYL The left channel's output history (y[n-1], y[n-2])
+\param pYR The right channel's output history
+*/
+/*----------------------------------------------------------------------------*/
+void Filter::processBiquad( float *pLSamples, float *pRSamples,
+                            const uint32_t n,
+                            const Coefficients &from, const Coefficients &to,
+                            double *pXL, double *pXR, double *pYL, double *pYR )
+{
+   if( n == 0 )
+      return;
+
+   const double step = 1.0 / (double)n;
+   const double da1 = ( to.a1 - from.a1 ) * step;
+   const double da2 = ( to.a2 - from.a2 ) * step;
+   const double da3 = ( to.a3 - from.a3 ) * step;
+   const double db1 = ( to.b1 - from.b1 ) * step;
+   const double db2 = ( to.b2 - from.b2 ) * step;
+
+   // Both channels are processed in lockstep, one SIMD lane per channel.
+   // The operations are the same as in the scalar version, so all variants
+   // produce identical results.
+#if defined( FILTER_SSE2 )
+   __m128d va1 = _mm_set1_pd( from.a1 );
+   __m128d va2 = _mm_set1_pd( from.a2 );
+   __m128d va3 = _mm_set1_pd( from.a3 );
+   __m128d vb1 = _mm_set1_pd( from.b1 );
+   __m128d vb2 = _mm_set1_pd( from.b2 );
+   const __m128d vda1 = _mm_set1_pd( da1 );
+   const __m128d vda2 = _mm_set1_pd( da2 );
+   const __m128d vda3 = _mm_set1_pd( da3 );
+   const __m128d vdb1 = _mm_set1_pd( db1 );
+   const __m128d vdb2 = _mm_set1_pd( db2 );
+   __m128d x1 = _mm_set_pd( pXR[0], pXL[0] );
+   __m128d x2 = _mm_set_pd( pXR[1], pXL[1] );
+   __m128d y1 = _mm_set_pd( pYR[0], pYL[0] );
+   __m128d y2 = _mm_set_pd( pYR[1], pYL[1] );
+
+   for( size_t i = 0; i < n; i++ )
+   {
+      va1 = _mm_add_pd( va1, vda1 );
+      va2 = _mm_add_pd( va2, vda2 );
+      va3 = _mm_add_pd( va3, vda3 );
+      vb1 = _mm_add_pd( vb1, vdb1 );
+      vb2 = _mm_add_pd( vb2, vdb2 );
+
+      __m128d x = _mm_set_pd( (double)pRSamples[i], (double)pLSamples[i] );
+      __m128d y = _mm_mul_pd( x, va1 );
+      y = _mm_add_pd( y, _mm_mul_pd( x1, va2 ) );
+      y = _mm_add_pd( y, _mm_mul_pd( x2, va3 ) );
+      y = _mm_sub_pd( y, _mm_mul_pd( y1, vb1 ) );
+      y = _mm_sub_pd( y, _mm_mul_pd( y2, vb2 ) );
+      y2 = y1;
+      y1 = y;
+      x2 = x1;
+      x1 = x;
+      pLSamples[i] = (float)_mm_cvtsd_f64( y );
+      pRSamples[i] = (float)_mm_cvtsd_f64( _mm_unpackhi_pd( y, y ) );
    }
 
-   for( size_t nChan = 0; nChan < 2; nChan++ )
+   _mm_storel_pd( &pXL[0], x1 );
+   _mm_storeh_pd( &pXR[0], x1 );
+   _mm_storel_pd( &pXL[1], x2 );
+   _mm_storeh_pd( &pXR[1], x2 );
+   _mm_storel_pd( &pYL[0], y1 );
+   _mm_storeh_pd( &pYR[0], y1 );
+   _mm_storel_pd( &pYL[1], y2 );
+   _mm_storeh_pd( &pYR[1], y2 );
+#elif defined( FILTER_NEON )
+   float64x2_t va1 = vdupq_n_f64( from.a1 );
+   float64x2_t va2 = vdupq_n_f64( from.a2 );
+   float64x2_t va3 = vdupq_n_f64( from.a3 );
+   float64x2_t vb1 = vdupq_n_f64( from.b1 );
+   float64x2_t vb2 = vdupq_n_f64( from.b2 );
+   const float64x2_t vda1 = vdupq_n_f64( da1 );
+   const float64x2_t vda2 = vdupq_n_f64( da2 );
+   const float64x2_t vda3 = vdupq_n_f64( da3 );
+   const float64x2_t vdb1 = vdupq_n_f64( db1 );
+   const float64x2_t vdb2 = vdupq_n_f64( db2 );
+   float64x2_t x1 = { pXL[0], pXR[0] };
+   float64x2_t x2 = { pXL[1], pXR[1] };
+   float64x2_t y1 = { pYL[0], pYR[0] };
+   float64x2_t y2 = { pYL[1], pYR[1] };
+
+   for( size_t i = 0; i < n; i++ )
    {
-      for( size_t i = 0; i < n; i++ )
-      {
-         double result =
-            + ( samples[nChan][i] * a1 )
-            +       ( X[nChan][0] * a2 )
-            +       ( X[nChan][1] * a3 )
-            -       ( Y[nChan][0] * b1 )
-            -       ( Y[nChan][1] * b2 );
-         Y[nChan][1] = Y[nChan][0];
-         Y[nChan][0] = result;
-         X[nChan][1] = X[nChan][0];
-         X[nChan][0] = samples[nChan][i];
-         samples[nChan][i] = (float)result;
-      }
+      va1 = vaddq_f64( va1, vda1 );
+      va2 = vaddq_f64( va2, vda2 );
+      va3 = vaddq_f64( va3, vda3 );
+      vb1 = vaddq_f64( vb1, vdb1 );
+      vb2 = vaddq_f64( vb2, vdb2 );
+
+      float64x2_t x = { (double)pLSamples[i], (double)pRSamples[i] };
+      float64x2_t y = vmulq_f64( x, va1 );
+      y = vaddq_f64( y, vmulq_f64( x1, va2 ) );
+      y = vaddq_f64( y, vmulq_f64( x2, va3 ) );
+      y = vsubq_f64( y, vmulq_f64( y1, vb1 ) );
+      y = vsubq_f64( y, vmulq_f64( y2, vb2 ) );
+      y2 = y1;
+      y1 = y;
+      x2 = x1;
+      x1 = x;
+      pLSamples[i] = (float)vgetq_lane_f64( y, 0 );
+      pRSamples[i] = (float)vgetq_lane_f64( y, 1 );
    }
+
+   pXL[0] = vgetq_lane_f64( x1, 0 );
+   pXR[0] = vgetq_lane_f64( x1, 1 );
+   pXL[1] = vgetq_lane_f64( x2, 0 );
+   pXR[1] = vgetq_lane_f64( x2, 1 );
+   pYL[0] = vgetq_lane_f64( y1, 0 );
+   pYR[0] = vgetq_lane_f64( y1, 1 );
+   pYL[1] = vgetq_lane_f64( y2, 0 );
+   pYR[1] = vgetq_lane_f64( y2, 1 );
+#else
+   double a1 = from.a1, a2 = from.a2, a3 = from.a3, b1 = from.b1, b2 = from.b2;
+   double xl1 = pXL[0], xl2 = pXL[1], yl1 = pYL[0], yl2 = pYL[1];
+   double xr1 = pXR[0], xr2 = pXR[1], yr1 = pYR[0], yr2 = pYR[1];
+
+   for( size_t i = 0; i < n; i++ )
+   {
+      a1 += da1;
+      a2 += da2;
+      a3 += da3;
+      b1 += db1;
+      b2 += db2;
+
+      double xl = pLSamples[i];
+      double xr = pRSamples[i];
+      double yl = ( xl * a1 ) + ( xl1 * a2 ) + ( xl2 * a3 ) - ( yl1 * b1 ) - ( yl2 * b2 );
+      double yr = ( xr * a1 ) + ( xr1 * a2 ) + ( xr2 * a3 ) - ( yr1 * b1 ) - ( yr2 * b2 );
+      yl2 = yl1;
+      yl1 = yl;
+      xl2 = xl1;
+      xl1 = xl;
+      yr2 = yr1;
+      yr1 = yr;
+      xr2 = xr1;
+      xr1 = xr;
+      pLSamples[i] = (float)yl;
+      pRSamples[i] = (float)yr;
+   }
+
+   pXL[0] = xl1;
+   pXL[1] = xl2;
+   pYL[0] = yl1;
+   pYL[1] = yl2;
+   pXR[0] = xr1;
+   pXR[1] = xr2;
+   pYR[0] = yr1;
+   pYR[1] = yr2;
+#endif
 }
 
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-11
-Apply the filter to audio data.
+Apply the filter to audio data. The coefficients move smoothly from the
+previous call's values to the ones for the current cutoff and resonance
+across the block, so modulations don't cause steps.
 \param pLSamples Left audio channel
 \param pRSamples Right audio channel
 \param n Number of samples
@@ -341,12 +615,25 @@ Apply the filter to audio data.
 /*----------------------------------------------------------------------------*/
 void Filter::process( float *pLSamples, float *pRSamples, const uint32_t n, double sampleRate )
 {
-   process(
-      pLSamples, pRSamples, n, sampleRate,
+   Coefficients to = coefficients(
       m_Type,
-      util::clamp( 0.0, 1.0, m_Cutoff * pow( 2.0, m_CutoffMod ) ),
+      util::clamp( 0.0, 1.0, m_Cutoff * fastExp2( m_CutoffMod ) ),
       util::clamp( 0.0, 1.0, m_Resonance + ( m_ResonanceMod / 100.0 ) ),
-      m_X[0], m_X[1], m_Y[0], m_Y[1] );
+      sampleRate );
+   Coefficients from = m_HasCoeffs ? m_Coeffs : to;
+
+   if( m_Type == TYPE_NONE && !m_HasCoeffs )
+   {
+      passThrough( pLSamples, pRSamples, n, m_X[0], m_X[1], m_Y[0], m_Y[1] );
+   } else
+   {
+      processBiquad( pLSamples, pRSamples, n, from, to, m_X[0], m_X[1], m_Y[0], m_Y[1] );
+   }
+
+   // An unfiltered voice doesn't need to ramp, unless it has just been
+   // switched off.
+   m_Coeffs = to;
+   m_HasCoeffs = m_Type != TYPE_NONE;
 }
 
 
@@ -49,11 +49,21 @@ namespace SamplerEngine
          TYPE_HIGHPASS
       };
 
+      struct Coefficients
+      {
+         double a1;
+         double a2;
+         double a3;
+         double b1;
+         double b2;
+      };
+
       Filter();
       Filter( const Filter &d );
       ~Filter();
 
       void getSettings( const Filter &d );
+      void reset();
 
       void setCutoff( double v );
       void setResonance( double v );
@@ -72,6 +82,10 @@ namespace SamplerEngine
       void process( float *pLSamples, float *pRSamples, const uint32_t n, double sampleRate );
       static void process( float *pLSamples, float *pRSamples, const uint32_t n, double sampleRate, Type type, double cutoff, double resonance, double *pXL, double *pXR, double *pYL, double *pYR );
 
+      static Coefficients coefficients( Type type, double cutoff, double resonance, double sampleRate );
+      static double fastTan( double x );
+      static double fastExp2( double x );
+
       static std::string toString( Type type );
       static Type fromString( const std::string &str );
       static std::set<Type> allTypes();
@@ -81,6 +95,10 @@ namespace SamplerEngine
 
    protected:
 
+   private:
+      static void passThrough( const float *pLSamples, const float *pRSamples, const uint32_t n, double *pXL, double *pXR, double *pYL, double *pYR );
+      static void processBiquad( float *pLSamples, float *pRSamples, const uint32_t n, const Coefficients &from, const Coefficients &to, double *pXL, double *pXR, double *pYL, double *pYR );
+
    private:
       Type m_Type;
       double m_CutoffMod;
@@ -89,6 +107,8 @@ namespace SamplerEngine
       double m_ResonanceMod;
       double m_X[2][2];
       double m_Y[2][2];
+      Coefficients m_Coeffs;
+      bool m_HasCoeffs;
    };
 }
 #endif
@@ -483,6 +483,21 @@ void LFO::setCustom( std::vector<double> v )
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Reset the LFO's state, so that the LFO object can be reused for a new note.
+*/
+/*----------------------------------------------------------------------------*/
+void LFO::reset()
+{
+   m_Value = 0.0;
+   m_Period = 0.0;
+   m_PeriodCount = 0;
+   m_TimeS = 0.0;
+   m_StartPhase = 0.0;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Called when the LFO is to be started.
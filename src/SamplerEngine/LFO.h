@@ -28,8 +28,11 @@
 #define __LFO_H__
 
 #include <set>
+#include <vector>
 #include <libxml/tree.h>
 
+#define LFO_MAXCUSTOMVALUES 128
+
 //==============================================================================
 namespace SamplerEngine
 {
@@ -106,6 +109,7 @@ namespace SamplerEngine
 
       std::vector<double> &getCustomRef();
 
+      void reset();
       void noteOn();
       void noteOff();
 
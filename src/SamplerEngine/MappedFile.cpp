@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file MappedFile.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Read-only memory mapped files
+*/
+/*----------------------------------------------------------------------------*/
+#include <filesystem>
+
+#ifdef _WIN32
+   #define NOMINMAX
+   #include <windows.h>
+#else
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
+
+#include "util.h"
+
+#include "MappedFile.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+MappedFile::MappedFile() :
+   m_pData( nullptr ),
+   m_Size( 0 ),
+   m_ModificationTime( 0 )
+#ifdef _WIN32
+   , m_hFile( INVALID_HANDLE_VALUE ),
+   m_hMapping( nullptr )
+#endif
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor. Unmaps the file.
+*/
+/*----------------------------------------------------------------------------*/
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+   if( m_pData )
+   {
+      UnmapViewOfFile( m_pData );
+   }
+   if( m_hMapping )
+   {
+      CloseHandle( m_hMapping );
+   }
+   if( m_hFile != INVALID_HANDLE_VALUE )
+   {
+      CloseHandle( m_hFile );
+   }
+#else
+   if( m_pData )
+   {
+      munmap( (void *)m_pData, m_Size );
+   }
+#endif
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Map a file into memory.
+\param fileName The file name
+\return The mapped file or nullptr on error (e.g. if the file doesn't exist or
+is empty)
+*/
+/*----------------------------------------------------------------------------*/
+MappedFile *MappedFile::open( const std::string &fileName )
+{
+   std::error_code ec;
+   std::filesystem::path path = std::filesystem::canonical( fileName, ec );
+   if( ec )
+      return( nullptr );
+
+   uintmax_t fileSize = std::filesystem::file_size( path, ec );
+   if( ec || fileSize == 0 || fileSize > SIZE_MAX )
+      return( nullptr );
+
+   auto writeTime = std::filesystem::last_write_time( path, ec );
+   if( ec )
+      return( nullptr );
+
+   MappedFile *pFile = new MappedFile();
+   pFile->m_Size = (size_t)fileSize;
+   pFile->m_ModificationTime = (int64_t)writeTime.time_since_epoch().count();
+   pFile->m_Identity = stdformat( "{}|{}|{}", path.string(), fileSize, pFile->m_ModificationTime );
+
+#ifdef _WIN32
+   pFile->m_hFile = CreateFileW( path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+   if( pFile->m_hFile == INVALID_HANDLE_VALUE )
+   {
+      delete pFile;
+      return( nullptr );
+   }
+
+   pFile->m_hMapping = CreateFileMappingW( pFile->m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+   if( !pFile->m_hMapping )
+   {
+      delete pFile;
+      return( nullptr );
+   }
+
+   pFile->m_pData = (const uint8_t *)MapViewOfFile( pFile->m_hMapping, FILE_MAP_READ, 0, 0, 0 );
+#else
+   int fd = ::open( path.c_str(), O_RDONLY );
+   if( fd < 0 )
+   {
+      delete pFile;
+      return( nullptr );
+   }
+
+   void *p = mmap( nullptr, pFile->m_Size, PROT_READ, MAP_SHARED, fd, 0 );
+   ::close( fd );
+
+   if( p != MAP_FAILED )
+   {
+      pFile->m_pData = (const uint8_t *)p;
+   }
+#endif
+
+   if( !pFile->m_pData )
+   {
+      delete pFile;
+      return( nullptr );
+   }
+
+   return( pFile );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The file's contents
+*/
+/*----------------------------------------------------------------------------*/
+const uint8_t *MappedFile::data() const
+{
+   return( m_pData );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The file's size in bytes
+*/
+/*----------------------------------------------------------------------------*/
+size_t MappedFile::size() const
+{
+   return( m_Size );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return A string identifying the file and its version (path, size and
+modification time)
+*/
+/*----------------------------------------------------------------------------*/
+const std::string &MappedFile::identity() const
+{
+   return( m_Identity );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The modification time of the file in ticks of the file system
+clock, only comparable on the same platform
+*/
+/*----------------------------------------------------------------------------*/
+int64_t MappedFile::modificationTime() const
+{
+   return( m_ModificationTime );
+}
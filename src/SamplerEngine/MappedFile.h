@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file MappedFile.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class MappedFile.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __MAPPEDFILE_H__
+#define __MAPPEDFILE_H__
+
+#include <stdint.h>
+#include <string>
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class MappedFile
+   \date  2026-10-17
+   A file mapped read-only into memory. The OS pages the contents in when
+   they are accessed and may drop them again under memory pressure.
+   */
+   /*----------------------------------------------------------------------------*/
+   class MappedFile
+   {
+   public:
+      ~MappedFile();
+
+      static MappedFile *open( const std::string &fileName );
+
+      const uint8_t *data() const;
+      size_t size() const;
+      const std::string &identity() const;
+      int64_t modificationTime() const;
+
+   private:
+      MappedFile();
+      MappedFile( const MappedFile & ) = delete;
+      MappedFile &operator=( const MappedFile & ) = delete;
+
+   private:
+      const uint8_t *m_pData;
+      size_t m_Size;
+      int64_t m_ModificationTime;
+      std::string m_Identity;
+#ifdef _WIN32
+      void *m_hFile;
+      void *m_hMapping;
+#endif
+   };
+}
+
+#endif
@@ -188,6 +188,88 @@ std::string ModMatrix::ModDestInfo::getUnit() const
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor. Compiles the enabled slots which have a source and a destination.
+\param slots The slots of the modulation matrix
+*/
+/*----------------------------------------------------------------------------*/
+ModMatrix::Routing::Routing( const std::vector<ModSlot *> &slots ) :
+   m_UsedSources( 0 )
+{
+   for( const ModSlot *pSlot : slots )
+   {
+      if( pSlot->isEnabled() && pSlot->getSrc() != ModSrc_None && pSlot->getDest() != ModDest_None )
+      {
+         m_Src.push_back( (uint8_t)pSlot->getSrc() );
+         m_Mod.push_back( (uint8_t)pSlot->getMod() );
+         m_Dest.push_back( (uint8_t)pSlot->getDest() );
+         m_Func.push_back( (uint8_t)pSlot->getMathFunc() );
+         m_Amount.push_back( pSlot->getAmount() );
+         m_UsedSources |= ( 1u << pSlot->getSrc() ) | ( 1u << pSlot->getMod() );
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+ModMatrix::Routing::~Routing()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of active routes
+*/
+/*----------------------------------------------------------------------------*/
+size_t ModMatrix::Routing::numRoutes() const
+{
+   return( m_Src.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return A bit mask of the modulation sources used by the routes, bit n
+corresponds to ModSrc value n
+*/
+/*----------------------------------------------------------------------------*/
+uint32_t ModMatrix::Routing::usedSources() const
+{
+   return( m_UsedSources );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Evaluate the routes. Safe to call from the audio thread.
+\param pSrcValues MODMATRIX_NUMSRC source values, indexed by ModSrc. Only the
+used sources need to be valid, ModSrc_None must be 1.0.
+\param pDestValues Receives MODMATRIX_NUMDEST destination values, indexed by
+ModDest. Destinations without any route are 0.0.
+*/
+/*----------------------------------------------------------------------------*/
+void ModMatrix::Routing::evaluate( const double *pSrcValues, double *pDestValues ) const
+{
+   for( size_t i = 0; i < MODMATRIX_NUMDEST; i++ )
+   {
+      pDestValues[i] = 0.0;
+   }
+
+   const size_t n = m_Src.size();
+   for( size_t i = 0; i < n; i++ )
+   {
+      double modVal = pSrcValues[m_Src[i]] * pSrcValues[m_Mod[i]] * m_Amount[i];
+      pDestValues[m_Dest[i]] += calc( (MathFunc)m_Func[i], modVal );
+   }
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Constructor
@@ -199,6 +281,7 @@ ModMatrix::ModSlot::ModSlot( ModMatrix::ModSrc src,
                              ModMatrix::MathFunc func,
                              double amt,
                              bool enabled ) :
+   m_pOwner( nullptr ),
    m_Enabled( enabled ),
    m_Src( src ),
    m_Mod( mod ),
@@ -215,6 +298,7 @@ Copy constructor
 */
 /*----------------------------------------------------------------------------*/
 ModMatrix::ModSlot::ModSlot( const ModSlot &d ) :
+   m_pOwner( nullptr ),
    m_Enabled( d.m_Enabled ),
    m_Src( d.m_Src ),
    m_Mod( d.m_Mod ),
@@ -225,12 +309,32 @@ ModMatrix::ModSlot::ModSlot( const ModSlot &d ) :
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Assignment operator. The slot stays part of its modulation matrix.
+*/
+/*----------------------------------------------------------------------------*/
+ModMatrix::ModSlot &ModMatrix::ModSlot::operator=( const ModSlot &d )
+{
+   m_Enabled = d.m_Enabled;
+   m_Src = d.m_Src;
+   m_Mod = d.m_Mod;
+   m_Dest = d.m_Dest;
+   m_Func = d.m_Func;
+   m_Amt = d.m_Amt;
+   changed();
+
+   return( *this );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Default constructor
 */
 /*----------------------------------------------------------------------------*/
 ModMatrix::ModSlot::ModSlot() :
+   m_pOwner( nullptr ),
    m_Enabled( false ),
    m_Src( ModMatrix::ModSrc_None ),
    m_Mod( ModMatrix::ModSrc_None ),
@@ -259,6 +363,7 @@ ModMatrix::ModSlot::~ModSlot()
 void ModMatrix::ModSlot::setDest( ModDest dest )
 {
    m_Dest = dest;
+   changed();
 }
 
 
@@ -281,6 +386,7 @@ ModMatrix::ModSrc ModMatrix::ModSlot::getSrc() const
 void ModMatrix::ModSlot::setSrc( ModSrc src )
 {
    m_Src = src;
+   changed();
 }
 
 
@@ -303,6 +409,7 @@ ModMatrix::MathFunc ModMatrix::ModSlot::getMathFunc() const
 void ModMatrix::ModSlot::setMathFunc( MathFunc f )
 {
    m_Func = f;
+   changed();
 }
 
 
@@ -325,6 +432,7 @@ ModMatrix::ModSrc ModMatrix::ModSlot::getMod() const
 void ModMatrix::ModSlot::setMod( ModSrc mod )
 {
    m_Mod = mod;
+   changed();
 }
 
 
@@ -358,6 +466,7 @@ double ModMatrix::ModSlot::getAmount() const
 void ModMatrix::ModSlot::setAmount( double amount )
 {
    m_Amt = amount;
+   changed();
 }
 
 
@@ -380,6 +489,21 @@ bool ModMatrix::ModSlot::isEnabled() const
 void ModMatrix::ModSlot::setEnabled( bool e )
 {
    m_Enabled = e;
+   changed();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Recompile the routing of the modulation matrix the slot belongs to.
+*/
+/*----------------------------------------------------------------------------*/
+void ModMatrix::ModSlot::changed()
+{
+   if( m_pOwner )
+   {
+      m_pOwner->compile();
+   }
 }
 
 
@@ -474,12 +598,14 @@ xmlNode *ModMatrix::ModSlot::toXml() const
 Constructor
 */
 /*----------------------------------------------------------------------------*/
-ModMatrix::ModMatrix( size_t numSlots )
+ModMatrix::ModMatrix( size_t numSlots ) :
+   m_Routing( nullptr )
 {
    for( size_t i = 0; i < numSlots; i++ )
    {
-      m_ModSlots.push_back( new ModSlot() );
+      addSlot( new ModSlot() );
    }
+   compile();
 }
 
 
@@ -525,7 +651,7 @@ ModMatrix *ModMatrix::fromXml( xmlNode *pe )
             ModSlot *pModSlot = ModSlot::fromXml( pChild );
             if( pModSlot )
             {
-               pModMatrix->m_ModSlots.push_back( pModSlot );
+               pModMatrix->addSlot( pModSlot );
                nSlots++;
             }
          }
@@ -536,10 +662,12 @@ ModMatrix *ModMatrix::fromXml( xmlNode *pe )
    {
       for( size_t i = 0; i < 5 - pModMatrix->m_ModSlots.size(); i++ )
       {
-         pModMatrix->m_ModSlots.push_back( new ModSlot() );
+         pModMatrix->addSlot( new ModSlot() );
       }
    }
 
+   pModMatrix->compile();
+
    return( pModMatrix );
 }
 
@@ -906,3 +1034,40 @@ ModMatrix::ModSlot *ModMatrix::getSlot( size_t n ) const
    return( m_ModSlots[n] );
 }
 
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Append a slot to the modulation matrix, which takes over its ownership.
+\param pSlot The slot
+*/
+/*----------------------------------------------------------------------------*/
+void ModMatrix::addSlot( ModSlot *pSlot )
+{
+   pSlot->m_pOwner = this;
+   m_ModSlots.push_back( pSlot );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Compile the enabled slots into a new routing and publish it to the voices.
+Called automatically whenever a slot is changed. Must not be called from the
+audio thread.
+*/
+/*----------------------------------------------------------------------------*/
+void ModMatrix::compile()
+{
+   m_Routing.publish( new Routing( m_ModSlots ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The compiled routing, see Routing
+*/
+/*----------------------------------------------------------------------------*/
+const Snapshot<const ModMatrix::Routing> &ModMatrix::routing() const
+{
+   return( m_Routing );
+}
+
@@ -27,13 +27,19 @@
 #ifndef __MODMATRIX_H__
 #define __MODMATRIX_H__
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <vector>
 
 #include <libxml/tree.h>
 
+#include "Snapshot.h"
+
 #define SAMPLERENGINE_NUMMODSLOTS 5
+// Size of arrays indexed by ModSrc/ModDest, i.e. the highest enum value + 1
+#define MODMATRIX_NUMSRC 15
+#define MODMATRIX_NUMDEST 7
 
 //==============================================================================
 namespace SamplerEngine
@@ -126,6 +132,37 @@ namespace SamplerEngine
       };
 
 
+      class ModSlot;
+
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class Routing
+      \date  2026-10-17
+      The enabled slots of a ModMatrix compiled into flat arrays, so that voices
+      can evaluate them without allocations or lookups. Source and destination
+      values are indexed by their ModSrc and ModDest enum values.
+      */
+      /*----------------------------------------------------------------------------*/
+      class Routing
+      {
+      public:
+         Routing( const std::vector<ModSlot *> &slots );
+         ~Routing();
+
+         size_t numRoutes() const;
+         uint32_t usedSources() const;
+         void evaluate( const double *pSrcValues, double *pDestValues ) const;
+
+      private:
+         std::vector<uint8_t> m_Src;
+         std::vector<uint8_t> m_Mod;
+         std::vector<uint8_t> m_Dest;
+         std::vector<uint8_t> m_Func;
+         std::vector<double> m_Amount;
+         uint32_t m_UsedSources;
+      };
+
+
       /*----------------------------------------------------------------------------*/
       /*!
       \class ModSlot
@@ -140,6 +177,8 @@ namespace SamplerEngine
          ModSlot();
          ~ModSlot();
 
+         ModSlot &operator=( const ModSlot &d );
+
          static ModSlot *fromXml( xmlNode *pe );
          xmlNode *toXml() const;
 
@@ -157,6 +196,10 @@ namespace SamplerEngine
          void setEnabled( bool e );
 
       private:
+         friend class ModMatrix;
+         void changed();
+
+         ModMatrix *m_pOwner;
          bool m_Enabled;
          ModSrc m_Src;
          ModSrc m_Mod;
@@ -171,6 +214,9 @@ namespace SamplerEngine
       size_t numSlots() const;
       ModSlot *getSlot( size_t n ) const;
 
+      void compile();
+      const Snapshot<const Routing> &routing() const;
+
       static ModMatrix *fromXml( xmlNode *pe );
       xmlNode *toXml() const;
 
@@ -190,7 +236,10 @@ namespace SamplerEngine
    protected:
 
    private:
+      void addSlot( ModSlot *pSlot );
+
       std::vector<ModSlot *> m_ModSlots;
+      Snapshot<const Routing> m_Routing;
    };
 }
 
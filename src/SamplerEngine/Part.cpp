@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <string>
 
+#include "SampleLoader.h"
 #include "SamplerEngine.h"
 #include "util.h"
 
@@ -40,8 +41,26 @@ Constructor
 Part::Part( size_t partNum, Engine *pEngine ) :
    m_PartNum( partNum ),
    m_pEngine( pEngine ),
-   m_Pitchbend( 0.0 )
+   m_Pitchbend( 0.0 ),
+   m_ZoneTable( new ZoneTable( m_Samples ) ),
+   m_ZoneChangeDepth( 0 ),
+   m_ZonesChanged( false ),
+   m_MaxVoices( SAMPLERENGINE_MAXVOICESPERPART ),
+   m_VoiceStealing( VoiceStealingOldest ),
+   m_Interpolation( SampleReader::InterpolationLinear ),
+   m_ModulationRate( VOICE_DEFAULT_MODRATE )
 {
+   for( size_t i = 0; i < MODMATRIX_NUMDEST; i++ )
+   {
+      m_AudioRateModulation[i] = false;
+   }
+
+   m_ActiveVoices.reserve( m_VoicePool.capacity() );
+   m_VoiceSlots.resize( m_VoicePool.capacity(), VoiceSlot{ PART_NOVOICE, PART_NOVOICE, PART_NOVOICE } );
+   for( size_t i = 0; i < ZONETABLE_NUMNOTES; i++ )
+   {
+      m_NoteVoices[i] = PART_NOVOICE;
+   }
 }
 
 
@@ -66,19 +85,23 @@ Part::~Part()
 /*! 2024-06-28
 Called on a regular bases to process the part and produce new audio data.
 \param buses The output buses to store new audio data in
+\param startSample The first sample within the output buses to be rendered
+\param numSamples The number of samples to be rendered
+\param scratch The scratch buffers the voices render into
 \param sampleRate The sample rate in Hz
 \param bpm The host's tempo in bom
 \return true if voices have been stopped
 */
 /*----------------------------------------------------------------------------*/
-bool Part::process( std::vector<OutputBus> &buses, double sampleRate, double bpm )
+bool Part::process( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples, const ScratchBuffer &scratch, double sampleRate, double bpm )
 {
-   std::set<Voice *> stoppedVoices;
-   int n = 0;
-   for( auto k = m_Voices.begin(); k != m_Voices.end(); k++ )
+   // Finished voices are dropped by compacting m_ActiveVoices in place,
+   // which keeps the remaining voices in their order
+   size_t numKept = 0;
+   for( size_t i = 0; i < m_ActiveVoices.size(); i++ )
    {
-      n++;
-      Voice *pVoice = k->second;
+      Voice *pVoice = m_ActiveVoices[i];
+      bool stopped = false;
       size_t busNum;
       if( pVoice->sample()->getOutputBus() < 0 )
          busNum = 0;
@@ -87,33 +110,49 @@ bool Part::process( std::vector<OutputBus> &buses, double sampleRate, double bpm
 
       if( busNum >= buses.size() )
       {
-         stoppedVoices.insert( pVoice );
+         stopped = true;
       } else
       if( !buses[busNum].isValid() )
       {
-         stoppedVoices.insert( pVoice );
+         stopped = true;
       } else
       if( buses[busNum].getWritePointers().size() != 2 )
       {
-         stoppedVoices.insert( pVoice );
+         stopped = true;
       } else
+      if( startSample + numSamples > buses[busNum].getNumSamples() )
       {
-         float *pLeft = buses[busNum].getWritePointers()[0];
-         float *pRight = buses[busNum].getWritePointers()[1];
+         stopped = true;
+      } else
+      {
+         float *pLeft = buses[busNum].getWritePointers()[0] + startSample;
+         float *pRight = buses[busNum].getWritePointers()[1] + startSample;
 
-         if( !pVoice->process( pLeft, pRight, buses[busNum].getNumSamples(), sampleRate, bpm ) )
+         if( !pVoice->process( pLeft, pRight, numSamples,
+                               scratch,
+                               sampleRate, bpm ) )
          {
-            stoppedVoices.insert( pVoice );
+            stopped = true;
          }
       }
-   }
 
-   if( stoppedVoices.size() > 0 )
-   {
-      for( auto v : stoppedVoices )
+      size_t nVoice = m_VoicePool.indexOf( pVoice );
+      if( stopped )
+      {
+         unlinkNoteVoice( nVoice );
+         m_VoiceSlots[nVoice].activePos = PART_NOVOICE;
+         m_VoicePool.release( pVoice );
+      } else
       {
-         stopVoice( v );
+         m_ActiveVoices[numKept] = pVoice;
+         m_VoiceSlots[nVoice].activePos = numKept;
+         numKept++;
       }
+   }
+
+   if( numKept < m_ActiveVoices.size() )
+   {
+      m_ActiveVoices.resize( numKept );
       return( true );
    } else
    {
@@ -122,6 +161,18 @@ bool Part::process( std::vector<OutputBus> &buses, double sampleRate, double bpm
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the part has any voices to be rendered, including stolen
+ones which are still fading out
+*/
+/*----------------------------------------------------------------------------*/
+bool Part::hasVoices() const
+{
+   return( !m_ActiveVoices.empty() );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Stop all voices.
@@ -129,49 +180,510 @@ Stop all voices.
 /*----------------------------------------------------------------------------*/
 void Part::stopAllVoices()
 {
-   for( auto v : m_Voices )
+   while( !m_ActiveVoices.empty() )
    {
-      delete v.second;
+      stopVoice( m_ActiveVoices.back() );
    }
-   m_Voices.clear();
 }
 
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
-Stop a specific voice.
+Stop a specific voice. The last active voice takes its place within
+m_ActiveVoices.
 \param pVoice The voice to be stopped
 */
 /*----------------------------------------------------------------------------*/
-void Part::stopVoice( const Voice *pVoice )
+void Part::stopVoice( Voice *pVoice )
+{
+   size_t nVoice = m_VoicePool.indexOf( pVoice );
+   if( nVoice >= m_VoiceSlots.size() )
+      return;
+
+   size_t pos = m_VoiceSlots[nVoice].activePos;
+   if( pos >= m_ActiveVoices.size() || m_ActiveVoices[pos] != pVoice )
+      return;
+
+   Voice *pLast = m_ActiveVoices.back();
+   m_ActiveVoices[pos] = pLast;
+   m_VoiceSlots[m_VoicePool.indexOf( pLast )].activePos = pos;
+   m_ActiveVoices.pop_back();
+
+   unlinkNoteVoice( nVoice );
+   m_VoiceSlots[nVoice].activePos = PART_NOVOICE;
+   m_VoicePool.release( pVoice );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Stop all voices playing a specific sample.
+\param pSample The sample
+*/
+/*----------------------------------------------------------------------------*/
+void Part::stopVoicesOfSample( const Sample *pSample )
+{
+   // Backwards, as stopVoice() moves the last voice into the gap
+   for( size_t i = m_ActiveVoices.size(); i > 0; i-- )
+   {
+      if( m_ActiveVoices[i - 1]->sample() == pSample )
+      {
+         stopVoice( m_ActiveVoices[i - 1] );
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Register a voice which has just been started.
+\param pVoice The voice, retrieved by allocateVoice()
+\param note The MIDI note number the voice is playing
+*/
+/*----------------------------------------------------------------------------*/
+void Part::addActiveVoice( Voice *pVoice, int note )
+{
+   size_t nVoice = m_VoicePool.indexOf( pVoice );
+   VoiceSlot &slot = m_VoiceSlots[nVoice];
+
+   slot.activePos = m_ActiveVoices.size();
+   m_ActiveVoices.push_back( pVoice );
+
+   slot.prevOnNote = PART_NOVOICE;
+   slot.nextOnNote = PART_NOVOICE;
+   if( note >= 0 && note < ZONETABLE_NUMNOTES )
+   {
+      slot.nextOnNote = m_NoteVoices[note];
+      if( slot.nextOnNote != PART_NOVOICE )
+      {
+         m_VoiceSlots[slot.nextOnNote].prevOnNote = nVoice;
+      }
+      m_NoteVoices[note] = nVoice;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Remove a voice from the list of voices playing its note.
+\param nVoice The position of the voice within the voice pool
+*/
+/*----------------------------------------------------------------------------*/
+void Part::unlinkNoteVoice( size_t nVoice )
+{
+   VoiceSlot &slot = m_VoiceSlots[nVoice];
+   int note = m_VoicePool.voice( nVoice )->midiNote();
+
+   if( slot.prevOnNote != PART_NOVOICE )
+   {
+      m_VoiceSlots[slot.prevOnNote].nextOnNote = slot.nextOnNote;
+   } else
+   if( note >= 0 && note < ZONETABLE_NUMNOTES && m_NoteVoices[note] == nVoice )
+   {
+      m_NoteVoices[note] = slot.nextOnNote;
+   }
+
+   if( slot.nextOnNote != PART_NOVOICE )
+   {
+      m_VoiceSlots[slot.nextOnNote].prevOnNote = slot.prevOnNote;
+   }
+
+   slot.prevOnNote = PART_NOVOICE;
+   slot.nextOnNote = PART_NOVOICE;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Retrieve an unused voice from the voice pool. If the part's or the engine's
+polyphony limit has been reached, a voice is stolen according to the part's
+voice stealing mode.
+\param note The MIDI note number of the new voice
+\return The new voice or nullptr if none is available
+*/
+/*----------------------------------------------------------------------------*/
+Voice *Part::allocateVoice( int note )
+{
+   if( numActiveVoices() >= m_MaxVoices )
+   {
+      Voice *pVictim = findVoiceToSteal( m_VoiceStealing, note );
+      if( pVictim )
+      {
+         stealVoice( pVictim );
+      }
+   }
+
+   if( m_pEngine && ( m_pEngine->numActiveVoices() >= m_pEngine->getMaxVoices() ) )
+   {
+      m_pEngine->stealVoice( m_VoiceStealing, note );
+   }
+
+   Voice *pVoice = m_VoicePool.allocate();
+   if( !pVoice )
+   {
+      // The pool is occupied by voices which are still fading out, so the
+      // oldest of them has to be cut off immediately.
+      Voice *pVictim = nullptr;
+      for( Voice *pActive : m_ActiveVoices )
+      {
+         if( pActive->isStolen() &&
+             ( !pVictim || pActive->getStartIndex() < pVictim->getStartIndex() ) )
+         {
+            pVictim = pActive;
+         }
+      }
+
+      if( !pVictim )
+      {
+         pVictim = findVoiceToSteal( m_VoiceStealing, note );
+      }
+
+      if( pVictim )
+      {
+         stopVoice( pVictim );
+         pVoice = m_VoicePool.allocate();
+      }
+   }
+
+   return( pVoice );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of voices currently playing, not counting voices that
+have been stolen and are fading out
+*/
+/*----------------------------------------------------------------------------*/
+size_t Part::numActiveVoices() const
 {
-   for( auto v = m_Voices.begin(); v != m_Voices.end(); v++ )
+   return( m_VoicePool.numActive() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Steal a voice in order to make room for a new voice. The voice fades out and
+no longer counts as active.
+\param pVoice The voice, retrieved by findVoiceToSteal()
+*/
+/*----------------------------------------------------------------------------*/
+void Part::stealVoice( Voice *pVoice )
+{
+   m_VoicePool.steal( pVoice );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Determine the voice to be stolen in order to make room for a new voice.
+\param mode The voice stealing mode
+\param note The MIDI note number of the new voice
+\return The voice to be stolen or nullptr if there is none
+*/
+/*----------------------------------------------------------------------------*/
+Voice *Part::findVoiceToSteal( VoiceStealing mode, int note ) const
+{
+   Voice *pBest = nullptr;
+   for( Voice *pVoice : m_ActiveVoices )
    {
-      if( v->second == pVoice )
+      if( !pVoice->isStolen() && isBetterVoiceToSteal( mode, note, pVoice, pBest ) )
       {
-         m_Voices.erase( v );
-         delete pVoice;
-         return;
+         pBest = pVoice;
       }
    }
+
+   return( pBest );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Compare two voices with regard to the voice stealing mode.
+\param mode The voice stealing mode
+\param note The MIDI note number of the new voice
+\param pVoice The voice to be checked
+\param pBest The best candidate found so far (may be nullptr)
+\return true if pVoice should rather be stolen than pBest
+*/
+/*----------------------------------------------------------------------------*/
+bool Part::isBetterVoiceToSteal( VoiceStealing mode, int note, const Voice *pVoice, const Voice *pBest )
+{
+   if( !pBest )
+      return( true );
+
+   if( mode == VoiceStealingSameNote )
+   {
+      bool a = ( pVoice->midiNote() == note );
+      bool b = ( pBest->midiNote() == note );
+      if( a != b )
+         return( a );
+   } else
+   if( mode == VoiceStealingReleasedFirst )
+   {
+      bool a = !pVoice->isNoteOn();
+      bool b = !pBest->isNoteOn();
+      if( a != b )
+         return( a );
+   } else
+   if( mode == VoiceStealingQuietest )
+   {
+      if( pVoice->getAmplitude() != pBest->getAmplitude() )
+         return( pVoice->getAmplitude() < pBest->getAmplitude() );
+   }
+
+   // Fall back to the oldest voice
+   return( pVoice->getStartIndex() < pBest->getStartIndex() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The maximum number of voices this part may play simultaneously
+*/
+/*----------------------------------------------------------------------------*/
+size_t Part::getMaxVoices() const
+{
+   return( m_MaxVoices );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param n The maximum number of voices this part may play simultaneously
+(1..SAMPLERENGINE_MAXVOICESPERPART)
+*/
+/*----------------------------------------------------------------------------*/
+void Part::setMaxVoices( size_t n )
+{
+   if( n < 1 )
+      n = 1;
+   else
+   if( n > m_VoicePool.capacity() )
+      n = m_VoicePool.capacity();
+
+   m_MaxVoices = n;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The voice stealing mode
+*/
+/*----------------------------------------------------------------------------*/
+Part::VoiceStealing Part::getVoiceStealing() const
+{
+   return( m_VoiceStealing );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param mode The new voice stealing mode
+*/
+/*----------------------------------------------------------------------------*/
+void Part::setVoiceStealing( VoiceStealing mode )
+{
+   m_VoiceStealing = mode;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The interpolation kernel used by the part's voices
+*/
+/*----------------------------------------------------------------------------*/
+SampleReader::Interpolation Part::getInterpolation() const
+{
+   return( m_Interpolation );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Select the interpolation kernel used by the part's voices. Higher quality
+kernels cost more CPU, so this allows budgeting the CPU load per part.
+Playing voices pick up the new kernel with their next block.
+\param interpolation The interpolation kernel
+*/
+/*----------------------------------------------------------------------------*/
+void Part::setInterpolation( SampleReader::Interpolation interpolation )
+{
+   m_Interpolation = interpolation;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The rate in Hz at which the part's voices evaluate their modulations
+*/
+/*----------------------------------------------------------------------------*/
+double Part::getModulationRate() const
+{
+   return( m_ModulationRate );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Set the rate at which the part's voices evaluate their modulation matrix and
+step their envelopes and LFOs. The rate is independent of the sample rate,
+so higher rates buy a finer modulation resolution with more CPU load.
+\param hz The modulation rate (VOICE_MIN_MODRATE..VOICE_MAX_MODRATE Hz)
+*/
+/*----------------------------------------------------------------------------*/
+void Part::setModulationRate( double hz )
+{
+   m_ModulationRate = util::clamp( VOICE_MIN_MODRATE, VOICE_MAX_MODRATE, hz );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param dest The modulation destination
+\return true if the destination is modulated at audio rate
+*/
+/*----------------------------------------------------------------------------*/
+bool Part::isAudioRateModulation( ModMatrix::ModDest dest ) const
+{
+   if( !supportsAudioRateModulation( dest ) )
+      return( false );
+
+   return( m_AudioRateModulation[dest] );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Select whether a modulation destination follows the modulation at audio rate
+rather than changing once per modulation step. The destination's value is
+interpolated per sample between the modulation steps, which costs extra CPU
+but avoids zipper noise. Only supported for the destinations for which
+supportsAudioRateModulation() returns true, ignored otherwise.
+\param dest The modulation destination
+\param enabled true to modulate the destination at audio rate
+*/
+/*----------------------------------------------------------------------------*/
+void Part::setAudioRateModulation( ModMatrix::ModDest dest, bool enabled )
+{
+   if( supportsAudioRateModulation( dest ) )
+   {
+      m_AudioRateModulation[dest] = enabled;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param dest The modulation destination
+\return true if the destination can be modulated at audio rate
+*/
+/*----------------------------------------------------------------------------*/
+bool Part::supportsAudioRateModulation( ModMatrix::ModDest dest )
+{
+   return( dest == ModMatrix::ModDest_Pitch || dest == ModMatrix::ModDest_FilterCutoff );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param mode The voice stealing mode
+\return A string representation of the voice stealing mode
+*/
+/*----------------------------------------------------------------------------*/
+std::string Part::toString( VoiceStealing mode )
+{
+   switch( mode )
+   {
+      case VoiceStealingOldest:
+         return( "Oldest" );
+         break;
+      case VoiceStealingQuietest:
+         return( "Quietest" );
+         break;
+      case VoiceStealingSameNote:
+         return( "SameNote" );
+         break;
+      case VoiceStealingReleasedFirst:
+         return( "ReleasedFirst" );
+         break;
+      default:
+         return( "Oldest" );
+         break;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param mode The string representation of a voice stealing mode
+\return The voice stealing mode
+*/
+/*----------------------------------------------------------------------------*/
+Part::VoiceStealing Part::voiceStealingFromString( const std::string &mode )
+{
+   if( mode == "Quietest" )
+   {
+      return( VoiceStealingQuietest );
+   } else
+   if( mode == "SameNote" )
+   {
+      return( VoiceStealingSameNote );
+   } else
+   if( mode == "ReleasedFirst" )
+   {
+      return( VoiceStealingReleasedFirst );
+   } else
+   {
+      return( VoiceStealingOldest );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return A set of all possible voice stealing modes
+*/
+/*----------------------------------------------------------------------------*/
+std::set<Part::VoiceStealing> Part::allVoiceStealingModes()
+{
+   return( std::set<VoiceStealing>( {
+      VoiceStealingOldest, VoiceStealingQuietest,
+      VoiceStealingSameNote, VoiceStealingReleasedFirst } ) );
 }
 
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Create an XML element from the Part settings.
+\param pState If not nullptr, the sample data is stored in this binary state
+rather than embedded into the XML
 \return Pointer to the new XML element
 */
 /*----------------------------------------------------------------------------*/
-xmlNode *Part::toXml() const
+xmlNode *Part::toXml( BinaryState *pState ) const
 {
    xmlNode *pePart = xmlNewNode( nullptr, (xmlChar *)"part" );
    xmlNewProp( pePart, (xmlChar *)"num", (xmlChar *)stdformat( "{}", m_PartNum ).c_str() );
+   xmlNewProp( pePart, (xmlChar *)"maxvoices", (xmlChar *)stdformat( "{}", m_MaxVoices ).c_str() );
+   xmlNewProp( pePart, (xmlChar *)"voicestealing", (xmlChar *)toString( m_VoiceStealing ).c_str() );
+   xmlNewProp( pePart, (xmlChar *)"interpolation", (xmlChar *)SampleReader::toString( m_Interpolation ).c_str() );
+   xmlNewProp( pePart, (xmlChar *)"modrate", (xmlChar *)stdformat( "{}", m_ModulationRate ).c_str() );
+
+   std::vector<std::string> audioRateMods;
+   for( ModMatrix::ModDest dest : ModMatrix::allModDest() )
+   {
+      if( isAudioRateModulation( dest ) )
+      {
+         audioRateMods.push_back( ModMatrix::toString( dest ) );
+      }
+   }
+   xmlNewProp( pePart, (xmlChar *)"audioratemods", (xmlChar *)util::strjoin( audioRateMods, "," ).c_str() );
 
    xmlNode *peSamples = xmlNewNode( nullptr, (xmlChar *)"samples" );
    for( Sample *pSample : m_Samples )
    {
-      xmlNode *peSample = pSample->toXml();
+      xmlNode *peSample = pSample->toXml( pState );
       xmlAddChild( peSamples, peSample );
 
    }
@@ -185,15 +697,23 @@ xmlNode *Part::toXml() const
 /*! 2024-06-28
 Reconstruct a Part object from a previously generated XML element (see toXml()).
 \param pe The XML element
+\param pState The binary state the XML has been read from, if any
+\param pLoader If given, the samples are not decoded right away but added
+to this loader, which inserts them into the part later on
 \return Pointer to the Part object or nullptr on error
 */
 /*----------------------------------------------------------------------------*/
-Part *Part::fromXml( xmlNode *pe )
+Part *Part::fromXml( xmlNode *pe, const BinaryState *pState, SampleLoader *pLoader )
 {
    if( std::string( (char*)pe->name ) != "part" )
       return( nullptr );
 
    size_t partNum = 0;
+   size_t maxVoices = SAMPLERENGINE_MAXVOICESPERPART;
+   VoiceStealing voiceStealing = VoiceStealingOldest;
+   SampleReader::Interpolation interpolation = SampleReader::InterpolationLinear;
+   double modulationRate = VOICE_DEFAULT_MODRATE;
+   std::vector<std::string> audioRateMods;
 
    for( xmlAttr *pAttr = pe->properties; pAttr; pAttr = pAttr->next )
    {
@@ -207,11 +727,39 @@ Part *Part::fromXml( xmlNode *pe )
          if( name == "num" )
          {
             partNum = std::stoul( value );
+         } else
+         if( name == "maxvoices" )
+         {
+            maxVoices = std::stoul( value );
+         } else
+         if( name == "voicestealing" )
+         {
+            voiceStealing = voiceStealingFromString( value );
+         } else
+         if( name == "interpolation" )
+         {
+            interpolation = SampleReader::interpolationFromString( value );
+         } else
+         if( name == "modrate" )
+         {
+            modulationRate = std::stod( value );
+         } else
+         if( name == "audioratemods" )
+         {
+            audioRateMods = util::strsplit( value, ",", false );
          }
       }
    }
 
    Part *pPart = new Part( partNum );
+   pPart->setMaxVoices( maxVoices );
+   pPart->setVoiceStealing( voiceStealing );
+   pPart->setInterpolation( interpolation );
+   pPart->setModulationRate( modulationRate );
+   for( const std::string &dest : audioRateMods )
+   {
+      pPart->setAudioRateModulation( ModMatrix::modDestFromString( dest ), true );
+   }
 
    for( xmlNode *p = pe->children; p; p = p->next )
    {
@@ -225,10 +773,17 @@ Part *Part::fromXml( xmlNode *pe )
                {
                   if( std::string( (char*)pSamples->name ) == "sample" )
                   {
-                     Sample *pSample = Sample::fromXml( pSamples );
-                     if( pSample )
+                     if( pLoader )
                      {
-                        pPart->m_Samples.push_back( pSample );
+                        pLoader->addXml( pSamples, pState, pPart );
+                     } else
+                     {
+                        Sample *pSample = Sample::fromXml( pSamples, pState );
+                        if( pSample )
+                        {
+                           pSample->m_pOwner = pPart;
+                           pPart->m_Samples.push_back( pSample );
+                        }
                      }
                   }
                }
@@ -237,6 +792,8 @@ Part *Part::fromXml( xmlNode *pe )
       }
    }
 
+   pPart->updateZones();
+
    return( pPart );
 }
 
@@ -294,7 +851,27 @@ void Part::addSample( Sample *pSample )
    if( containsSample( pSample ) )
       return;
 
+   pSample->m_pOwner = this;
    m_Samples.push_back( pSample );
+   updateZones();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Append a list of new samples to this part in a single step.
+\param samples The samples, the list is empty afterwards
+*/
+/*----------------------------------------------------------------------------*/
+void Part::addSamples( std::list<Sample *> &samples )
+{
+   for( Sample *pSample : samples )
+   {
+      pSample->m_pOwner = this;
+   }
+
+   m_Samples.splice( m_Samples.end(), samples );
+   updateZones();
 }
 
 
@@ -307,24 +884,15 @@ deleted from memory.
 /*----------------------------------------------------------------------------*/
 void Part::removeSample( Sample *pSample )
 {
-   std::vector<Voice *> voicesToStop;
-   for( std::pair<int, Voice *> sv : m_Voices )
-   {
-      if( sv.second->sample() == pSample )
-      {
-         voicesToStop.push_back( sv.second );
-      }
-   }
+   if( !containsSample( pSample ) )
+      return;
 
-   for( Voice *pVoice : voicesToStop )
-   {
-      stopVoice( pVoice );
-   }
+   // Unpublish the sample first, so no new voice can pick it up
+   m_Samples.remove( pSample );
+   pSample->m_pOwner = nullptr;
+   publishZones();
 
-   if( containsSample( pSample ) )
-   {
-      m_Samples.remove( pSample );
-   }
+   stopVoicesOfSample( pSample );
 }
 
 
@@ -337,50 +905,80 @@ deleted from memory.
 /*----------------------------------------------------------------------------*/
 void Part::deleteSample( Sample *pSample )
 {
-   std::vector<Voice *> voicesToStop;
-   for( std::pair<int, Voice *> sv : m_Voices )
-   {
-      if( sv.second->sample() == pSample )
-      {
-         voicesToStop.push_back( sv.second );
-      }
-   }
+   if( !containsSample( pSample ) )
+      return;
+
+   // Unpublish the sample first, so no new voice can pick it up
+   m_Samples.remove( pSample );
+   publishZones();
+
+   stopVoicesOfSample( pSample );
+
+   delete pSample;
+}
 
-   for( Voice *pVoice : voicesToStop )
-   {
-      stopVoice( pVoice );
-   }
 
-   if( std::find( m_Samples.begin(), m_Samples.end(), pSample ) != m_Samples.end() )
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Rebuild the note/velocity index of the samples and publish it to the audio
+thread. Must be called whenever a sample is added or its note or velocity
+range changes. Between beginZoneChanges() and endZoneChanges(), the rebuild
+is deferred until the end.
+*/
+/*----------------------------------------------------------------------------*/
+void Part::updateZones()
+{
+   if( m_ZoneChangeDepth > 0 )
    {
-      m_Samples.remove( pSample );
-      delete pSample;
+      m_ZonesChanged = true;
+   } else
+   {
+      publishZones();
    }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-Retrieve all samples matching a specific MIDI note number and velocity.
-\param note The MIDI note number
-\param vel the MIDI velocity
-\return A list of all matching samples
+/*! 2026-10-17
+Start a batch of zone changes, e.g. when moving many samples at once. Calls
+may be nested.
+*/
+/*----------------------------------------------------------------------------*/
+void Part::beginZoneChanges()
+{
+   m_ZoneChangeDepth++;
+}
 
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+End a batch of zone changes and publish the index if anything has changed.
 */
 /*----------------------------------------------------------------------------*/
-std::list<Sample *> Part::getSamplesByMidiNoteAndVelocity( int note, int vel ) const
+void Part::endZoneChanges()
 {
-   std::list<Sample *> result;
+   if( m_ZoneChangeDepth > 0 )
+   {
+      m_ZoneChangeDepth--;
+   }
 
-   for( Sample *pSample : m_Samples )
+   if( m_ZoneChangeDepth == 0 && m_ZonesChanged )
    {
-      if( pSample->matchesMidiNote( note ) && pSample->matchesVelocity( vel ) )
-      {
-         result.push_back( pSample );
-      }
+      publishZones();
    }
+}
 
-   return( result );
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Rebuild and publish the note/velocity index immediately. Waits until the
+audio thread has stopped using the previous one.
+*/
+/*----------------------------------------------------------------------------*/
+void Part::publishZones()
+{
+   m_ZoneTable.publish( new ZoneTable( m_Samples ) );
+   m_ZonesChanged = false;
 }
 
 
@@ -392,9 +990,9 @@ std::list<Sample *> Part::getSamplesByMidiNoteAndVelocity( int note, int vel ) c
 /*----------------------------------------------------------------------------*/
 bool Part::isPlaying( const Sample *pSample ) const
 {
-   for( auto v : m_Voices )
+   for( const Voice *pVoice : m_ActiveVoices )
    {
-      if( v.second->sample() == pSample )
+      if( pVoice->sample() == pSample )
       {
          return( true );
       }
@@ -404,6 +1002,32 @@ bool Part::isPlaying( const Sample *pSample ) const
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true unless the engine renders offline
+*/
+/*----------------------------------------------------------------------------*/
+bool Part::isRealtime() const
+{
+   return( !m_pEngine || m_pEngine->isRealtime() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Report a disk streaming underrun of one of the part's voices to the engine's
+host.
+*/
+/*----------------------------------------------------------------------------*/
+void Part::countUnderrun() const
+{
+   if( m_pEngine )
+   {
+      m_pEngine->host().countUnderrun();
+   }
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Trigger a note on event.
@@ -413,25 +1037,22 @@ Trigger a note on event.
 /*----------------------------------------------------------------------------*/
 void Part::noteOn( int note, int vel )
 {
-   std::list<Sample *> s = getSamplesByMidiNoteAndVelocity( note, vel );
+   Snapshot<const ZoneTable>::Reader zoneTable( m_ZoneTable );
+   size_t numZones = zoneTable->numZones( note, vel );
+   Sample *const *ppZones = zoneTable->zones( note, vel );
 
-   bool isSoloEnabled = false;
-   std::set<Sample *> selectedSamples;
-   if( m_pEngine )
+   for( size_t i = 0; i < numZones; i++ )
    {
-      isSoloEnabled = m_pEngine->isSoloEnabled();
-      if( isSoloEnabled )
+      Sample *pSample = ppZones[i];
+      if( !m_pEngine || m_pEngine->isAudible( pSample ) )
       {
-         selectedSamples = m_pEngine->getSelectedSamples();
-      }
-   }
+         Voice *pVoice = allocateVoice( note );
+         if( !pVoice )
+            break;
 
-   for( Sample *pSample : s )
-   {
-      if( !isSoloEnabled || ( selectedSamples.find( pSample ) != selectedSamples.end() ) )
-      {
-         Voice *pVoice = new Voice( this, pSample, note, vel );
-         m_Voices.insert( std::pair{ note, pVoice } );
+         uint64_t startIndex = m_pEngine ? m_pEngine->nextVoiceStartIndex() : 0;
+         pVoice->start( this, pSample, note, vel, startIndex );
+         addActiveVoice( pVoice, note );
       }
    }
 }
@@ -446,14 +1067,12 @@ Trigger a note off event.
 /*----------------------------------------------------------------------------*/
 void Part::noteOff( int note, int /*vel*/ )
 {
-   if( m_Voices.count( note ) > 0 )
+   if( note < 0 || note >= ZONETABLE_NUMNOTES )
+      return;
+
+   for( size_t nVoice = m_NoteVoices[note]; nVoice != PART_NOVOICE; nVoice = m_VoiceSlots[nVoice].nextOnNote )
    {
-      auto v = m_Voices.equal_range( note );
-      for( auto voice = v.first; voice != v.second; voice++ )
-      {
-         Voice *pVoice = voice->second;
-         pVoice->noteOff();
-      }
+      m_VoicePool.voice( nVoice )->noteOff();
    }
 }
 
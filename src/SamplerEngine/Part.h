@@ -29,16 +29,23 @@
 
 #include <list>
 #include <map>
+#include <vector>
 #include <libxml/tree.h>
 
 #include "Sample.h"
+#include "Snapshot.h"
 #include "Voice.h"
+#include "VoicePool.h"
+#include "ZoneTable.h"
+
+#define PART_NOVOICE (~(size_t)0)
 
 //==============================================================================
 namespace SamplerEngine
 {
    class OutputBus;
    class Engine;
+   class SampleLoader;
 
    /*----------------------------------------------------------------------------*/
    /*!
@@ -49,6 +56,14 @@ namespace SamplerEngine
    class Part
    {
    public:
+      enum VoiceStealing
+      {
+         VoiceStealingOldest = 1,
+         VoiceStealingQuietest,
+         VoiceStealingSameNote,
+         VoiceStealingReleasedFirst
+      };
+
       Part( size_t partNum, Engine *pEngine  = nullptr );
       ~Part();
 
@@ -71,19 +86,66 @@ namespace SamplerEngine
       void deleteSample( Sample *pSample );
       void removeSample( Sample *pSample );
       void addSample( Sample *pSample );
+      void addSamples( std::list<Sample *> &samples );
+      void updateZones();
+      void beginZoneChanges();
+      void endZoneChanges();
 
       bool isPlaying( const Sample *pSample ) const;
 
 
-      static Part *fromXml( xmlNode *pe );
-      xmlNode *toXml() const;
-
-      bool process( std::vector<OutputBus> &buses, double sampleRate, double bpm );
+      size_t getMaxVoices() const;
+      void setMaxVoices( size_t n );
+      VoiceStealing getVoiceStealing() const;
+      void setVoiceStealing( VoiceStealing mode );
+      SampleReader::Interpolation getInterpolation() const;
+      void setInterpolation( SampleReader::Interpolation interpolation );
+      double getModulationRate() const;
+      void setModulationRate( double hz );
+      bool isAudioRateModulation( ModMatrix::ModDest dest ) const;
+      void setAudioRateModulation( ModMatrix::ModDest dest, bool enabled );
+      size_t numActiveVoices() const;
+      bool isRealtime() const;
+      void countUnderrun() const;
+      Voice *findVoiceToSteal( VoiceStealing mode, int note ) const;
+      void stealVoice( Voice *pVoice );
+
+      static bool isBetterVoiceToSteal( VoiceStealing mode, int note, const Voice *pVoice, const Voice *pBest );
+      static std::string toString( VoiceStealing mode );
+      static VoiceStealing voiceStealingFromString( const std::string &mode );
+      static std::set<VoiceStealing> allVoiceStealingModes();
+      static bool supportsAudioRateModulation( ModMatrix::ModDest dest );
+
+      static Part *fromXml( xmlNode *pe, const BinaryState *pState = nullptr, SampleLoader *pLoader = nullptr );
+      xmlNode *toXml( BinaryState *pState = nullptr ) const;
+
+      bool process( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples, const ScratchBuffer &scratch, double sampleRate, double bpm );
+      bool hasVoices() const;
 
    private:
-      std::list<Sample *> getSamplesByMidiNoteAndVelocity( int note, int vel ) const;
-      void stopVoice( const Voice *pVoice );
+      void publishZones();
+      void addActiveVoice( Voice *pVoice, int note );
+      void unlinkNoteVoice( size_t nVoice );
+      void stopVoice( Voice *pVoice );
+      void stopVoicesOfSample( const Sample *pSample );
       void stopAllVoices();
+      Voice *allocateVoice( int note );
+
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class VoiceSlot
+      \date  2026-10-17
+      Bookkeeping for the voice at the same position within the voice pool:
+      where it is within m_ActiveVoices and its neighbours within the list of
+      voices playing the same note.
+      */
+      /*----------------------------------------------------------------------------*/
+      struct VoiceSlot
+      {
+         size_t activePos;
+         size_t prevOnNote;
+         size_t nextOnNote;
+      };
 
    private:
       size_t m_PartNum;
@@ -91,7 +153,18 @@ namespace SamplerEngine
       double m_Pitchbend;
       std::map<int, double> m_ControllerValues;
       std::list<Sample *> m_Samples;
-      std::multimap<int, Voice *> m_Voices;
+      Snapshot<const ZoneTable> m_ZoneTable;
+      int m_ZoneChangeDepth;
+      bool m_ZonesChanged;
+      VoicePool m_VoicePool;
+      std::vector<Voice *> m_ActiveVoices;
+      std::vector<VoiceSlot> m_VoiceSlots;
+      size_t m_NoteVoices[ZONETABLE_NUMNOTES];
+      size_t m_MaxVoices;
+      VoiceStealing m_VoiceStealing;
+      SampleReader::Interpolation m_Interpolation;
+      double m_ModulationRate;
+      bool m_AudioRateModulation[MODMATRIX_NUMDEST];
    };
 }
 
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file Reclaimer.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class Reclaimer.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __RECLAIMER_H__
+#define __RECLAIMER_H__
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class Reclaimer
+   \date  2026-10-17
+   Deletes objects on a background thread. Used for objects which are
+   expensive to free, like a replaced Engine with all of its samples, so
+   that neither the audio thread nor the message thread has to wait for it.
+   */
+   /*----------------------------------------------------------------------------*/
+   template<class T>
+   class Reclaimer
+   {
+   public:
+      Reclaimer() :
+         m_Quit( false ),
+         m_Thread( &Reclaimer::run, this )
+      {
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Destructor. Deletes all objects which are still pending.
+      */
+      /*----------------------------------------------------------------------------*/
+      ~Reclaimer()
+      {
+         {
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            m_Quit = true;
+         }
+         m_Condition.notify_one();
+         m_Thread.join();
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Delete an object on the background thread. Must not be called from the
+      audio thread.
+      \param pObject The object, ownership is taken over
+      */
+      /*----------------------------------------------------------------------------*/
+      void reclaim( T *pObject )
+      {
+         if( !pObject )
+            return;
+
+         {
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            m_Pending.push_back( pObject );
+         }
+         m_Condition.notify_one();
+      }
+
+   private:
+      Reclaimer( const Reclaimer & ) = delete;
+      Reclaimer &operator=( const Reclaimer & ) = delete;
+
+      void run()
+      {
+         std::unique_lock<std::mutex> lock( m_Mutex );
+
+         while( true )
+         {
+            m_Condition.wait( lock, [this]{ return( m_Quit || !m_Pending.empty() ); } );
+
+            std::vector<T *> objects;
+            objects.swap( m_Pending );
+
+            lock.unlock();
+            for( T *pObject : objects )
+            {
+               delete pObject;
+            }
+            lock.lock();
+
+            if( m_Quit && m_Pending.empty() )
+               break;
+         }
+      }
+
+   private:
+      std::mutex m_Mutex;
+      std::condition_variable m_Condition;
+      std::vector<T *> m_Pending;
+      bool m_Quit;
+      std::thread m_Thread;
+   };
+}
+
+#endif
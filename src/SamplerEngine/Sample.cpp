@@ -25,6 +25,7 @@
 */
 /*----------------------------------------------------------------------------*/
 #include "Sample.h"
+#include "Part.h"
 
 #include "util.h"
 
@@ -37,6 +38,7 @@ Constructor
 */
 /*----------------------------------------------------------------------------*/
 Sample::Sample( std::string name, WaveFile *pWave, int minNote, int maxNote, int nLayer ) :
+   m_pOwner( nullptr ),
    m_Name( name ),
    m_OutputBus( 0 ),
    m_pAEG( nullptr ),
@@ -76,6 +78,7 @@ Constructor
 */
 /*----------------------------------------------------------------------------*/
 Sample::Sample() :
+   m_pOwner( nullptr ),
    m_Name( "" ),
    m_OutputBus( 0 ),
    m_pAEG( nullptr ),
@@ -124,10 +127,12 @@ Sample::~Sample()
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Create an XML element from the Sample settings.
+\param pState If not nullptr, the sample data is stored in this binary state
+rather than embedded into the XML
 \return Pointer to the new XML element
 */
 /*----------------------------------------------------------------------------*/
-xmlNode *Sample::toXml() const
+xmlNode *Sample::toXml( BinaryState *pState ) const
 {
    xmlNode *peSample = xmlNewNode( nullptr, (xmlChar *)"sample" );
    xmlNewProp( peSample, (xmlChar *)"name", (xmlChar *)m_Name.c_str() );
@@ -212,7 +217,7 @@ xmlNode *Sample::toXml() const
    xmlNode *peModMatrix = m_pModMatrix->toXml();
    xmlAddChild( peSample, peModMatrix );
 
-   xmlNode *peWave = m_pWave->toXml();
+   xmlNode *peWave = m_pWave->toXml( pState );
    xmlAddChild( peSample, peWave );
 
    return( peSample );
@@ -223,10 +228,11 @@ xmlNode *Sample::toXml() const
 /*! 2024-06-28
 Reconstruct a Sample object from a previously generated XML element (see toXml()).
 \param pe The XML element
+\param pState The binary state the XML has been read from, if any
 \return Pointer to the Sample object or nullptr on error
 */
 /*----------------------------------------------------------------------------*/
-Sample *Sample::fromXml( xmlNode *pe )
+Sample *Sample::fromXml( xmlNode *pe, const BinaryState *pState )
 {
    if( std::string( (char*)pe->name ) != "sample" )
       return( nullptr );
@@ -403,8 +409,7 @@ Sample *Sample::fromXml( xmlNode *pe )
       } else
       if( tagName == "wave" )
       {
-         pWave = WaveFile::fromXml( pChild );
-         pWave->dft();
+         pWave = WaveFile::fromXml( pChild, pState );
       }
    }
 
@@ -808,7 +813,11 @@ int Sample::getMaxNote() const
 /*----------------------------------------------------------------------------*/
 void Sample::setMinNote( int note )
 {
-   m_MinNote = note;
+   if( m_MinNote != note )
+   {
+      m_MinNote = note;
+      zonesChanged();
+   }
 }
 
 
@@ -819,7 +828,11 @@ void Sample::setMinNote( int note )
 /*----------------------------------------------------------------------------*/
 void Sample::setMaxNote( int note )
 {
-   m_MaxNote = note;
+   if( m_MaxNote != note )
+   {
+      m_MaxNote = note;
+      zonesChanged();
+   }
 }
 
 
@@ -841,7 +854,11 @@ int Sample::getMinVelocity() const
 /*----------------------------------------------------------------------------*/
 void Sample::setMinVelocity( int v )
 {
-   m_MinVelocity = v;
+   if( m_MinVelocity != v )
+   {
+      m_MinVelocity = v;
+      zonesChanged();
+   }
 }
 
 
@@ -863,7 +880,11 @@ int Sample::getMaxVelocity() const
 /*----------------------------------------------------------------------------*/
 void Sample::setMaxVelocity( int v )
 {
-   m_MaxVelocity = v;
+   if( m_MaxVelocity != v )
+   {
+      m_MaxVelocity = v;
+      zonesChanged();
+   }
 }
 
 
@@ -879,6 +900,7 @@ void Sample::correctMinMaxNote()
       int tmp = m_MinNote;
       m_MinNote = m_MaxNote;
       m_MaxNote = tmp;
+      zonesChanged();
    }
 }
 
@@ -1036,3 +1058,18 @@ int Sample::getLayer() const
    return( m_NLayer );
 }
 
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Let the part owning this sample know that its note or velocity range has
+changed.
+*/
+/*----------------------------------------------------------------------------*/
+void Sample::zonesChanged()
+{
+   if( m_pOwner )
+   {
+      m_pOwner->updateZones();
+   }
+}
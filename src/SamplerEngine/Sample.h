@@ -42,6 +42,8 @@
 //==============================================================================
 namespace SamplerEngine
 {
+   class Part;
+
    /*----------------------------------------------------------------------------*/
    /*!
    \class Sample
@@ -62,8 +64,8 @@ namespace SamplerEngine
       Sample( std::string name, WaveFile *pWave, int minNote, int maxNote, int nLayer );
       ~Sample();
 
-      static Sample *fromXml( xmlNode *pe );
-      xmlNode *toXml() const;
+      static Sample *fromXml( xmlNode *pe, const BinaryState *pState = nullptr );
+      xmlNode *toXml( BinaryState *pState = nullptr ) const;
 
       std::string getName() const;
       void setName( std::string name );
@@ -114,8 +116,12 @@ namespace SamplerEngine
    protected:
 
    private:
+      friend class Part;
+
       Sample();
+      void zonesChanged();
 
+      Part *m_pOwner;
       std::string m_Name;
       int m_OutputBus;
       ENV *m_pAEG;
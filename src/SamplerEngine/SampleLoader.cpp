@@ -0,0 +1,319 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file SampleLoader.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class loads samples in parallel on background threads.
+*/
+/*----------------------------------------------------------------------------*/
+#include <list>
+#include <map>
+
+#include "Part.h"
+#include "Sample.h"
+#include "SampleLoader.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+SampleLoader::SampleLoader() :
+   m_NextJob( 0 ),
+   m_NumDone( 0 ),
+   m_Cancel( false )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor. Cancels all jobs which have not been started yet, waits for the
+running ones and deletes all results which have not been taken over.
+*/
+/*----------------------------------------------------------------------------*/
+SampleLoader::~SampleLoader()
+{
+   cancel();
+
+   for( Job &job : m_Jobs )
+   {
+      delete job.pSample;
+      delete job.pWave;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add a job loading a wave file. Must be called before start().
+\param fileName The file name
+\param loadMode How to load the audio data
+\return The job number
+*/
+/*----------------------------------------------------------------------------*/
+size_t SampleLoader::addFile( const std::string &fileName, WaveFile::LoadMode loadMode )
+{
+   m_Jobs.push_back( { fileName, loadMode, nullptr, nullptr, nullptr, nullptr, nullptr } );
+   return( m_Jobs.size() - 1 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add a job decoding a <sample> XML element (see Sample::fromXml()). Must be
+called before start(). The XML document must not be modified or freed
+until the loader is finished.
+\param pe The XML element
+\param pState The binary state the XML has been read from, if any
+\param pPart The part the sample is inserted into by insertSamples(), if any
+\return The job number
+*/
+/*----------------------------------------------------------------------------*/
+size_t SampleLoader::addXml( xmlNode *pe, const BinaryState *pState, Part *pPart )
+{
+   m_Jobs.push_back( { std::string(), WaveFile::LoadModeRead, pe, pState, pPart, nullptr, nullptr } );
+   return( m_Jobs.size() - 1 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Start processing the jobs in the background. Returns immediately.
+\param numThreads The number of threads to use, 0 for one per CPU core
+*/
+/*----------------------------------------------------------------------------*/
+void SampleLoader::start( size_t numThreads )
+{
+   if( !m_Threads.empty() )
+      return;
+
+   if( numThreads == 0 )
+      numThreads = std::thread::hardware_concurrency();
+   // hardware_concurrency() returns 0 if it can't tell
+   if( numThreads == 0 )
+      numThreads = 1;
+   if( numThreads > m_Jobs.size() )
+      numThreads = m_Jobs.size();
+   if( numThreads > SAMPLELOADER_MAXTHREADS )
+      numThreads = SAMPLELOADER_MAXTHREADS;
+
+   m_Threads.reserve( numThreads );
+   for( size_t i = 0; i < numThreads; i++ )
+   {
+      m_Threads.emplace_back( &SampleLoader::workerMain, this );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Wait until all jobs are finished.
+*/
+/*----------------------------------------------------------------------------*/
+void SampleLoader::wait()
+{
+   for( std::thread &thread : m_Threads )
+   {
+      thread.join();
+   }
+   m_Threads.clear();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Skip all jobs which have not been started yet and wait for the running ones.
+*/
+/*----------------------------------------------------------------------------*/
+void SampleLoader::cancel()
+{
+   m_Cancel.store( true, std::memory_order_relaxed );
+   wait();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of jobs
+*/
+/*----------------------------------------------------------------------------*/
+size_t SampleLoader::numJobs() const
+{
+   return( m_Jobs.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of jobs which are finished (or have been skipped)
+*/
+/*----------------------------------------------------------------------------*/
+size_t SampleLoader::numDone() const
+{
+   return( m_NumDone.load( std::memory_order_acquire ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The progress from 0 to 1
+*/
+/*----------------------------------------------------------------------------*/
+double SampleLoader::getProgress() const
+{
+   if( m_Jobs.empty() )
+      return( 1.0 );
+
+   return( (double)numDone() / (double)m_Jobs.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if all jobs are finished. The results may be accessed then,
+even if wait() has not been called.
+*/
+/*----------------------------------------------------------------------------*/
+bool SampleLoader::isFinished() const
+{
+   return( numDone() == m_Jobs.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nJob The job number
+\return The file name of a job added by addFile()
+*/
+/*----------------------------------------------------------------------------*/
+const std::string &SampleLoader::getFileName( size_t nJob ) const
+{
+   return( m_Jobs[nJob].fileName );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Take over the wave file loaded by a job added by addFile(). Must only be
+called once the loader is finished.
+\param nJob The job number
+\return The wave file or nullptr on error; ownership is passed to the caller
+*/
+/*----------------------------------------------------------------------------*/
+WaveFile *SampleLoader::takeWave( size_t nJob )
+{
+   WaveFile *pWave = m_Jobs[nJob].pWave;
+   m_Jobs[nJob].pWave = nullptr;
+   return( pWave );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Take over the sample decoded by a job added by addXml(). Must only be
+called once the loader is finished.
+\param nJob The job number
+\return The sample or nullptr on error; ownership is passed to the caller
+*/
+/*----------------------------------------------------------------------------*/
+Sample *SampleLoader::takeSample( size_t nJob )
+{
+   Sample *pSample = m_Jobs[nJob].pSample;
+   m_Jobs[nJob].pSample = nullptr;
+   return( pSample );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Insert all decoded samples which have not been taken over into the parts
+given to addXml(), keeping their order. Each part receives all of its
+samples at once. Must only be called once the loader is finished.
+\return The number of inserted samples
+*/
+/*----------------------------------------------------------------------------*/
+size_t SampleLoader::insertSamples()
+{
+   std::map<Part *, std::list<Sample *>> samples;
+   size_t n = 0;
+
+   for( size_t i = 0; i < m_Jobs.size(); i++ )
+   {
+      if( m_Jobs[i].pPart && m_Jobs[i].pSample )
+      {
+         samples[m_Jobs[i].pPart].push_back( takeSample( i ) );
+         n++;
+      }
+   }
+
+   for( auto &it : samples )
+   {
+      it.first->addSamples( it.second );
+   }
+
+   return( n );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Thread function: claim and run jobs until none are left.
+*/
+/*----------------------------------------------------------------------------*/
+void SampleLoader::workerMain()
+{
+   while( true )
+   {
+      size_t nJob = m_NextJob.fetch_add( 1, std::memory_order_relaxed );
+      if( nJob >= m_Jobs.size() )
+         break;
+
+      if( !m_Cancel.load( std::memory_order_relaxed ) )
+      {
+         runJob( nJob );
+      }
+      m_NumDone.fetch_add( 1, std::memory_order_release );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Run a single job. Only touches the job's own results.
+\param nJob The job number
+*/
+/*----------------------------------------------------------------------------*/
+void SampleLoader::runJob( size_t nJob )
+{
+   Job &job = m_Jobs[nJob];
+
+   if( job.pNode )
+   {
+      job.pSample = Sample::fromXml( job.pNode, job.pState );
+   } else
+   {
+      job.pWave = WaveFile::load( job.fileName, job.loadMode );
+   }
+}
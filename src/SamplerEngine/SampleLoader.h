@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file SampleLoader.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class SampleLoader.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __SAMPLELOADER_H__
+#define __SAMPLELOADER_H__
+
+#include <stddef.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <libxml/tree.h>
+
+#include "WaveFile.h"
+
+#define SAMPLELOADER_MAXTHREADS 32
+
+//==============================================================================
+namespace SamplerEngine
+{
+   class BinaryState;
+   class Part;
+   class Sample;
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class SampleLoader
+   \date  2026-10-17
+   Loads wave files or decodes <sample> XML elements on a set of background
+   threads. Jobs are added first, then start() runs them in parallel while
+   the caller polls the progress. The results keep the order in which the
+   jobs were added, and all finished samples can be inserted into their
+   parts in one go, so a part never shows a half loaded set of samples.
+   */
+   /*----------------------------------------------------------------------------*/
+   class SampleLoader
+   {
+   public:
+      SampleLoader();
+      ~SampleLoader();
+
+      size_t addFile( const std::string &fileName, WaveFile::LoadMode loadMode );
+      size_t addXml( xmlNode *pe, const BinaryState *pState, Part *pPart );
+
+      void start( size_t numThreads = 0 );
+      void wait();
+      void cancel();
+
+      size_t numJobs() const;
+      size_t numDone() const;
+      double getProgress() const;
+      bool isFinished() const;
+
+      const std::string &getFileName( size_t nJob ) const;
+      WaveFile *takeWave( size_t nJob );
+      Sample *takeSample( size_t nJob );
+      size_t insertSamples();
+
+   private:
+      SampleLoader( const SampleLoader & ) = delete;
+      SampleLoader &operator=( const SampleLoader & ) = delete;
+
+      void workerMain();
+      void runJob( size_t nJob );
+
+   private:
+      struct Job
+      {
+         std::string fileName;
+         WaveFile::LoadMode loadMode;
+         xmlNode *pNode;
+         const BinaryState *pState;
+         Part *pPart;
+         WaveFile *pWave;
+         Sample *pSample;
+      };
+
+      std::vector<Job> m_Jobs;
+      std::vector<std::thread> m_Threads;
+      std::atomic<size_t> m_NextJob;
+      std::atomic<size_t> m_NumDone;
+      std::atomic<bool> m_Cancel;
+   };
+}
+
+#endif
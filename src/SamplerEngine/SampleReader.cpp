@@ -0,0 +1,497 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file SampleReader.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Selection of the sample reader functions
+*/
+/*----------------------------------------------------------------------------*/
+#include <math.h>
+#include "SampleReader.h"
+#include "DiskStreamer.h"
+#include "WaveFile.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+SampleValueReader for a specific sample format and number of channels
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT, int NCHANNELS>
+static float readValue( const WaveFile *pWave, int nChannel, uint32_t nSample )
+{
+   return( SampleReader::value<FORMAT, NCHANNELS>( pWave->data8(), nChannel, nSample ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+SampleBlockReader for a specific sample format, number of channels and
+interpolation kernel
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT, int NCHANNELS, int INTERPOLATION>
+static void readBlock( const WaveFile *pWave, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight )
+{
+   SampleReader::RawFrames<FORMAT, NCHANNELS> frames( pWave->data8(), pWave->numSamples() );
+   SampleReader::block<INTERPOLATION>( frames, pLoop, pPositions, n, pLeft, pRight );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+SampleStreamReader for a specific sample format, number of channels and
+interpolation kernel
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT, int NCHANNELS, int INTERPOLATION>
+static bool readStream( const StreamCache *pCache, const DiskStream *pStream, uint32_t numSamples, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight )
+{
+   StreamFrames<FORMAT, NCHANNELS> frames( pCache, pStream, numSamples );
+   SampleReader::block<INTERPOLATION>( frames, pLoop, pPositions, n, pLeft, pRight );
+   return( frames.isComplete() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+SampleValueReader for planar float data
+*/
+/*----------------------------------------------------------------------------*/
+static float readPlanarValue( const WaveFile *pWave, int nChannel, uint32_t nSample )
+{
+   return( pWave->floatData( nChannel )[nSample] );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+SampleBlockReader for planar float data and a specific interpolation kernel
+*/
+/*----------------------------------------------------------------------------*/
+template<int INTERPOLATION>
+static void readPlanarBlock( const WaveFile *pWave, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight )
+{
+   SampleReader::PlanarFrames frames( pWave->floatData( 0 ), pWave->floatData( 1 ), pWave->numSamples() );
+   SampleReader::block<INTERPOLATION>( frames, pLoop, pPositions, n, pLeft, pRight );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation The interpolation kernel
+\return readBlock<FORMAT, NCHANNELS, interpolation>
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT, int NCHANNELS>
+static SampleBlockReader rawBlockReader( SampleReader::Interpolation interpolation )
+{
+   switch( interpolation )
+   {
+      case SampleReader::InterpolationNone:
+         return( readBlock<FORMAT, NCHANNELS, SampleReader::InterpolationNone> );
+      case SampleReader::InterpolationLinear:
+         return( readBlock<FORMAT, NCHANNELS, SampleReader::InterpolationLinear> );
+      case SampleReader::InterpolationHermite:
+         return( readBlock<FORMAT, NCHANNELS, SampleReader::InterpolationHermite> );
+      case SampleReader::InterpolationSinc:
+         return( readBlock<FORMAT, NCHANNELS, SampleReader::InterpolationSinc> );
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation The interpolation kernel
+\return readStream<FORMAT, NCHANNELS, interpolation>
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT, int NCHANNELS>
+static SampleStreamReader rawStreamReader( SampleReader::Interpolation interpolation )
+{
+   switch( interpolation )
+   {
+      case SampleReader::InterpolationNone:
+         return( readStream<FORMAT, NCHANNELS, SampleReader::InterpolationNone> );
+      case SampleReader::InterpolationLinear:
+         return( readStream<FORMAT, NCHANNELS, SampleReader::InterpolationLinear> );
+      case SampleReader::InterpolationHermite:
+         return( readStream<FORMAT, NCHANNELS, SampleReader::InterpolationHermite> );
+      case SampleReader::InterpolationSinc:
+         return( readStream<FORMAT, NCHANNELS, SampleReader::InterpolationSinc> );
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nChannels The number of channels
+\return readValue<FORMAT, nChannels> or nullptr
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT>
+static SampleValueReader formatValueReader( int nChannels )
+{
+   if( nChannels == 1 )
+      return( readValue<FORMAT, 1> );
+   else
+   if( nChannels == 2 )
+      return( readValue<FORMAT, 2> );
+   else
+      return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nChannels The number of channels
+\param interpolation The interpolation kernel
+\return The matching readBlock<FORMAT, ...> or nullptr
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT>
+static SampleBlockReader formatBlockReader( int nChannels, SampleReader::Interpolation interpolation )
+{
+   if( nChannels == 1 )
+      return( rawBlockReader<FORMAT, 1>( interpolation ) );
+   else
+   if( nChannels == 2 )
+      return( rawBlockReader<FORMAT, 2>( interpolation ) );
+   else
+      return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nChannels The number of channels
+\param interpolation The interpolation kernel
+\return The matching readStream<FORMAT, ...> or nullptr
+*/
+/*----------------------------------------------------------------------------*/
+template<int FORMAT>
+static SampleStreamReader formatStreamReader( int nChannels, SampleReader::Interpolation interpolation )
+{
+   if( nChannels == 1 )
+      return( rawStreamReader<FORMAT, 1>( interpolation ) );
+   else
+   if( nChannels == 2 )
+      return( rawStreamReader<FORMAT, 2>( interpolation ) );
+   else
+      return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param format The sample format
+\param nChannels The number of channels
+\return The matching SampleValueReader or nullptr if the format isn't supported
+*/
+/*----------------------------------------------------------------------------*/
+SampleValueReader SampleReader::valueReader( SampleFormat format, int nChannels )
+{
+   switch( format )
+   {
+      case SampleFormatInt8:
+         return( formatValueReader<SampleFormatInt8>( nChannels ) );
+      case SampleFormatInt16:
+         return( formatValueReader<SampleFormatInt16>( nChannels ) );
+      case SampleFormatInt24:
+         return( formatValueReader<SampleFormatInt24>( nChannels ) );
+      case SampleFormatInt32:
+         return( formatValueReader<SampleFormatInt32>( nChannels ) );
+      case SampleFormatFloat32:
+         return( formatValueReader<SampleFormatFloat32>( nChannels ) );
+      case SampleFormatFloat64:
+         return( formatValueReader<SampleFormatFloat64>( nChannels ) );
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param format The sample format
+\param nChannels The number of channels
+\param interpolation The interpolation kernel
+\return The matching SampleBlockReader or nullptr if the format isn't supported
+*/
+/*----------------------------------------------------------------------------*/
+SampleBlockReader SampleReader::blockReader( SampleFormat format, int nChannels, Interpolation interpolation )
+{
+   switch( format )
+   {
+      case SampleFormatInt8:
+         return( formatBlockReader<SampleFormatInt8>( nChannels, interpolation ) );
+      case SampleFormatInt16:
+         return( formatBlockReader<SampleFormatInt16>( nChannels, interpolation ) );
+      case SampleFormatInt24:
+         return( formatBlockReader<SampleFormatInt24>( nChannels, interpolation ) );
+      case SampleFormatInt32:
+         return( formatBlockReader<SampleFormatInt32>( nChannels, interpolation ) );
+      case SampleFormatFloat32:
+         return( formatBlockReader<SampleFormatFloat32>( nChannels, interpolation ) );
+      case SampleFormatFloat64:
+         return( formatBlockReader<SampleFormatFloat64>( nChannels, interpolation ) );
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param format The sample format
+\param nChannels The number of channels
+\param interpolation The interpolation kernel
+\return The matching SampleStreamReader or nullptr if the format isn't
+supported
+*/
+/*----------------------------------------------------------------------------*/
+SampleStreamReader SampleReader::streamReader( SampleFormat format, int nChannels, Interpolation interpolation )
+{
+   switch( format )
+   {
+      case SampleFormatInt8:
+         return( formatStreamReader<SampleFormatInt8>( nChannels, interpolation ) );
+      case SampleFormatInt16:
+         return( formatStreamReader<SampleFormatInt16>( nChannels, interpolation ) );
+      case SampleFormatInt24:
+         return( formatStreamReader<SampleFormatInt24>( nChannels, interpolation ) );
+      case SampleFormatInt32:
+         return( formatStreamReader<SampleFormatInt32>( nChannels, interpolation ) );
+      case SampleFormatFloat32:
+         return( formatStreamReader<SampleFormatFloat32>( nChannels, interpolation ) );
+      case SampleFormatFloat64:
+         return( formatStreamReader<SampleFormatFloat64>( nChannels, interpolation ) );
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param format The sample format
+\return The size of a single raw sample in bytes
+*/
+/*----------------------------------------------------------------------------*/
+size_t SampleReader::bytesPerSample( SampleFormat format )
+{
+   switch( format )
+   {
+      case SampleFormatInt8:
+         return( bytesPerSample<SampleFormatInt8>() );
+      case SampleFormatInt16:
+         return( bytesPerSample<SampleFormatInt16>() );
+      case SampleFormatInt24:
+         return( bytesPerSample<SampleFormatInt24>() );
+      case SampleFormatInt32:
+         return( bytesPerSample<SampleFormatInt32>() );
+      case SampleFormatFloat32:
+         return( bytesPerSample<SampleFormatFloat32>() );
+      case SampleFormatFloat64:
+         return( bytesPerSample<SampleFormatFloat64>() );
+   }
+
+   return( 0 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param format The sample format
+\return The sample format's name
+*/
+/*----------------------------------------------------------------------------*/
+std::string SampleReader::toString( SampleFormat format )
+{
+   switch( format )
+   {
+      case SampleFormatInt8:
+         return( "8bit" );
+      case SampleFormatInt16:
+         return( "16bit" );
+      case SampleFormatInt24:
+         return( "24bit" );
+      case SampleFormatInt32:
+         return( "32bit" );
+      case SampleFormatFloat32:
+         return( "32bit float" );
+      case SampleFormatFloat64:
+         return( "64bit float" );
+   }
+
+   return( std::string() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The SampleValueReader for waves stored as planar float data
+*/
+/*----------------------------------------------------------------------------*/
+SampleValueReader SampleReader::planarValueReader()
+{
+   return( readPlanarValue );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation The interpolation kernel
+\return The SampleBlockReader for waves stored as planar float data
+*/
+/*----------------------------------------------------------------------------*/
+SampleBlockReader SampleReader::planarBlockReader( Interpolation interpolation )
+{
+   switch( interpolation )
+   {
+      case InterpolationNone:
+         return( readPlanarBlock<InterpolationNone> );
+      case InterpolationLinear:
+         return( readPlanarBlock<InterpolationLinear> );
+      case InterpolationHermite:
+         return( readPlanarBlock<InterpolationHermite> );
+      case InterpolationSinc:
+         return( readPlanarBlock<InterpolationSinc> );
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Build the polyphase table of a Blackman windowed sinc lowpass with cutoff
+SAMPLEREADER_SINCCUTOFF (relative to Nyquist). Each phase is normalized to
+unity gain at DC.
+\param pTable The table to be filled
+*/
+/*----------------------------------------------------------------------------*/
+static void buildSincTable( SampleReader::SincTable *pTable )
+{
+   const double halfWidth = SAMPLEREADER_SINCTAPS / 2;
+
+   for( int phase = 0; phase <= SAMPLEREADER_SINCPHASES; phase++ )
+   {
+      const double frac = (double)phase / (double)SAMPLEREADER_SINCPHASES;
+      double coeffs[SAMPLEREADER_SINCTAPS];
+      double sum = 0.0;
+
+      for( int k = 0; k < SAMPLEREADER_SINCTAPS; k++ )
+      {
+         // distance between tap k and the interpolated position
+         const double t = (double)( k - ( SAMPLEREADER_SINCTAPS / 2 ) + 1 ) - frac;
+         const double x = M_PI * t * SAMPLEREADER_SINCCUTOFF;
+         const double sinc = fabs( x ) < 1e-9 ? 1.0 : sin( x ) / x;
+         const double w = fabs( t ) >= halfWidth ? 0.0 :
+            0.42 + ( 0.5 * cos( M_PI * t / halfWidth ) ) + ( 0.08 * cos( 2.0 * M_PI * t / halfWidth ) );
+
+         coeffs[k] = sinc * w;
+         sum += coeffs[k];
+      }
+
+      for( int k = 0; k < SAMPLEREADER_SINCTAPS; k++ )
+      {
+         pTable->coeffs[phase][k] = (float)( coeffs[k] / sum );
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The polyphase windowed-sinc table, built on first use.
+*/
+/*----------------------------------------------------------------------------*/
+const SampleReader::SincTable &SampleReader::sincTable()
+{
+   static const SincTable *pTable = []()
+   {
+      static SincTable table;
+      buildSincTable( &table );
+      return( &table );
+   }();
+
+   return( *pTable );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation
+\return The interpolation kernel's name
+*/
+/*----------------------------------------------------------------------------*/
+std::string SampleReader::toString( Interpolation interpolation )
+{
+   if( interpolation == InterpolationNone )
+      return( "None" );
+   else
+   if( interpolation == InterpolationLinear )
+      return( "Linear" );
+   else
+   if( interpolation == InterpolationHermite )
+      return( "Hermite" );
+   else
+   if( interpolation == InterpolationSinc )
+      return( "Sinc" );
+   else
+      return( std::string() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation The interpolation kernel's name
+\return The interpolation kernel, InterpolationLinear if the name is unknown
+*/
+/*----------------------------------------------------------------------------*/
+SampleReader::Interpolation SampleReader::interpolationFromString( const std::string &interpolation )
+{
+   for( Interpolation i : allInterpolations() )
+   {
+      if( toString( i ) == interpolation )
+         return( i );
+   }
+
+   return( InterpolationLinear );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return All interpolation kernels
+*/
+/*----------------------------------------------------------------------------*/
+std::set<SampleReader::Interpolation> SampleReader::allInterpolations()
+{
+   return( std::set<Interpolation>( { InterpolationNone, InterpolationLinear, InterpolationHermite, InterpolationSinc } ) );
+}
@@ -0,0 +1,552 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file SampleReader.h
+\author Christian Nowak <chnowak@web.de>
+\brief Functions for reading sample data, specialized at compile time by
+sample format, number of channels and interpolation kernel.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __SAMPLEREADER_H__
+#define __SAMPLEREADER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <set>
+#include <string>
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+#define SAMPLEREADER_SSE
+#include <xmmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#define SAMPLEREADER_NEON
+#include <arm_neon.h>
+#endif
+
+#define SAMPLEREADER_SINCTAPS 16
+#define SAMPLEREADER_SINCPHASES 256
+#define SAMPLEREADER_SINCCUTOFF 0.9
+#define SAMPLEREADER_NUMINTERPOLATIONS 4
+
+//==============================================================================
+namespace SamplerEngine
+{
+   class WaveFile;
+   class StreamCache;
+   class DiskStream;
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   Reads a single sample value of a specific channel.
+   */
+   /*----------------------------------------------------------------------------*/
+   typedef float ( *SampleValueReader )( const WaveFile *pWave, int nChannel, uint32_t nSample );
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class SampleLoop
+   \date  2026-10-17
+   \brief The loop a voice is playing, as seen by the interpolation kernels.
+   The loop consists of the frames first .. first + length - 1. Taps behind
+   it continue at its start if wrapAbove is set, taps before it continue at
+   its end if wrapBelow is set.
+   */
+   /*----------------------------------------------------------------------------*/
+   struct SampleLoop
+   {
+      int64_t first;
+      int64_t length;
+      bool wrapBelow;
+      bool wrapAbove;
+   };
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   Reads n stereo frames at the given sample positions. Mono waves are
+   written to both channels. pLoop is nullptr unless the voice is looping.
+   */
+   /*----------------------------------------------------------------------------*/
+   typedef void ( *SampleBlockReader )( const WaveFile *pWave, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight );
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   Reads n stereo frames of a streamed wave at the given sample positions
+   from its resident parts and a voice's DiskStream. Returns false if frames
+   had to be replaced by silence because they weren't loaded.
+   */
+   /*----------------------------------------------------------------------------*/
+   typedef bool ( *SampleStreamReader )( const StreamCache *pCache, const DiskStream *pStream, uint32_t numSamples, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight );
+
+   namespace SampleReader
+   {
+      enum Interpolation
+      {
+         InterpolationNone = 1,
+         InterpolationLinear,
+         InterpolationHermite,
+         InterpolationSinc
+      };
+
+      enum SampleFormat
+      {
+         SampleFormatInt8 = 1,
+         SampleFormatInt16,
+         SampleFormatInt24,
+         SampleFormatInt32,
+         SampleFormatFloat32,
+         SampleFormatFloat64
+      };
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      \return The size of a single raw sample of the format FORMAT in bytes
+      */
+      /*----------------------------------------------------------------------------*/
+      template<int FORMAT>
+      constexpr size_t bytesPerSample()
+      {
+         return( FORMAT == SampleFormatInt8 ? 1 :
+                 FORMAT == SampleFormatInt16 ? 2 :
+                 FORMAT == SampleFormatInt24 ? 3 :
+                 FORMAT == SampleFormatFloat64 ? 8 : 4 );
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Convert a single raw sample to a floating point value. Float data is
+      little endian IEEE 754 like the host's, so it is used as it is.
+      \param p Pointer to the raw sample data
+      \return The sample value (-1..1)
+      */
+      /*----------------------------------------------------------------------------*/
+      template<int FORMAT>
+      inline float decode( const uint8_t *p );
+
+      template<>
+      inline float decode<SampleFormatInt8>( const uint8_t *p )
+      {
+         // 8bit WAV data is unsigned
+         return( (float)( (int)p[0] - 128 ) / 128.0f );
+      }
+
+      template<>
+      inline float decode<SampleFormatInt16>( const uint8_t *p )
+      {
+         int16_t v = (int16_t)( p[0] | ( p[1] << 8 ) );
+         return( (float)v / 32768.0f );
+      }
+
+      template<>
+      inline float decode<SampleFormatInt24>( const uint8_t *p )
+      {
+         // Shift into the upper bits and back down to extend the sign
+         int32_t v = (int32_t)( ( (uint32_t)p[0] << 8 ) | ( (uint32_t)p[1] << 16 ) | ( (uint32_t)p[2] << 24 ) ) >> 8;
+         return( (float)v / 8388608.0f );
+      }
+
+      template<>
+      inline float decode<SampleFormatInt32>( const uint8_t *p )
+      {
+         int32_t v = (int32_t)( (uint32_t)p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 ) );
+         return( (float)v / 2147483648.0f );
+      }
+
+      template<>
+      inline float decode<SampleFormatFloat32>( const uint8_t *p )
+      {
+         float v;
+         memcpy( &v, p, sizeof( v ) );
+         return( v );
+      }
+
+      template<>
+      inline float decode<SampleFormatFloat64>( const uint8_t *p )
+      {
+         double v;
+         memcpy( &v, p, sizeof( v ) );
+         return( (float)v );
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      4-point, 3rd-order Hermite interpolation between y0 and y1.
+      \param x The fractional position (0..1)
+      \return The interpolated value
+      */
+      /*----------------------------------------------------------------------------*/
+      inline float hermite( float x, float ym1, float y0, float y1, float y2 )
+      {
+         const float c1 = 0.5f * ( y1 - ym1 );
+         const float c2 = ym1 - ( 2.5f * y0 ) + ( 2.0f * y1 ) - ( 0.5f * y2 );
+         const float c3 = ( 0.5f * ( y2 - ym1 ) ) + ( 1.5f * ( y0 - y1 ) );
+         return( ( ( ( ( c3 * x ) + c2 ) * x ) + c1 ) * x + y0 );
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      \param pData Pointer to the interleaved raw sample data
+      \param nChannel The channel number
+      \param nSample The sample number
+      \return The sample value (-1..1)
+      */
+      /*----------------------------------------------------------------------------*/
+      template<int FORMAT, int NCHANNELS>
+      inline float value( const uint8_t *pData, int nChannel, uint32_t nSample )
+      {
+         constexpr size_t frameSize = (size_t)NCHANNELS * bytesPerSample<FORMAT>();
+         size_t nChan = NCHANNELS == 1 ? 0 : (size_t)nChannel;
+         return( decode<FORMAT>( pData + ( (size_t)nSample * frameSize ) + ( nChan * bytesPerSample<FORMAT>() ) ) );
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Precomputed polyphase windowed-sinc kernel. Each of the
+      SAMPLEREADER_SINCPHASES + 1 rows holds the SAMPLEREADER_SINCTAPS
+      coefficients for one fractional position, covering the taps
+      -SAMPLEREADER_SINCTAPS / 2 + 1 .. SAMPLEREADER_SINCTAPS / 2 around the
+      integer position. The rows are aligned for SIMD loads.
+      */
+      /*----------------------------------------------------------------------------*/
+      struct SincTable
+      {
+         alignas( 64 ) float coeffs[SAMPLEREADER_SINCPHASES + 1][SAMPLEREADER_SINCTAPS];
+      };
+
+      const SincTable &sincTable();
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      \param a SAMPLEREADER_SINCTAPS values
+      \param b SAMPLEREADER_SINCTAPS coefficients, 16 byte aligned
+      \return The dot product of a and b
+      */
+      /*----------------------------------------------------------------------------*/
+      inline float dot( const float *a, const float *b )
+      {
+#if defined( SAMPLEREADER_SSE )
+         __m128 acc = _mm_mul_ps( _mm_loadu_ps( a ), _mm_load_ps( b ) );
+         for( int i = 4; i < SAMPLEREADER_SINCTAPS; i += 4 )
+         {
+            acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( a + i ), _mm_load_ps( b + i ) ) );
+         }
+         acc = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) );
+         acc = _mm_add_ss( acc, _mm_shuffle_ps( acc, acc, 0x55 ) );
+         return( _mm_cvtss_f32( acc ) );
+#elif defined( SAMPLEREADER_NEON )
+         float32x4_t acc = vmulq_f32( vld1q_f32( a ), vld1q_f32( b ) );
+         for( int i = 4; i < SAMPLEREADER_SINCTAPS; i += 4 )
+         {
+            acc = vmlaq_f32( acc, vld1q_f32( a + i ), vld1q_f32( b + i ) );
+         }
+         float32x2_t sum = vadd_f32( vget_low_f32( acc ), vget_high_f32( acc ) );
+         return( vget_lane_f32( vpadd_f32( sum, sum ), 0 ) );
+#else
+         float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+         for( int i = 0; i < SAMPLEREADER_SINCTAPS; i += 4 )
+         {
+            acc[0] += a[i] * b[i];
+            acc[1] += a[i + 1] * b[i + 1];
+            acc[2] += a[i + 2] * b[i + 2];
+            acc[3] += a[i + 3] * b[i + 3];
+         }
+         return( ( acc[0] + acc[1] ) + ( acc[2] + acc[3] ) );
+#endif
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class RawFrames
+      \date  2026-10-17
+      \brief Access to interleaved raw sample data. Indices outside the wave
+      are clamped to its first or last frame.
+      */
+      /*----------------------------------------------------------------------------*/
+      template<int FORMAT, int NCHANNELS>
+      class RawFrames
+      {
+      public:
+         RawFrames( const uint8_t *pData, uint32_t numSamples ) :
+            m_pData( pData ),
+            m_Last( (int64_t)numSamples - 1 )
+         {
+         }
+
+         inline int64_t last() const
+         {
+            return( m_Last );
+         }
+
+         inline void get( int64_t i, float &l, float &r ) const
+         {
+            constexpr size_t frameSize = (size_t)NCHANNELS * bytesPerSample<FORMAT>();
+            i = i < 0 ? 0 : ( i > m_Last ? m_Last : i );
+
+            const uint8_t *p = m_pData + ( (size_t)i * frameSize );
+            l = decode<FORMAT>( p );
+            r = NCHANNELS == 1 ? l : decode<FORMAT>( p + bytesPerSample<FORMAT>() );
+         }
+
+         inline void sinc( int64_t i, const float *pCoeffs, float &l, float &r ) const
+         {
+            alignas( 16 ) float tapsL[SAMPLEREADER_SINCTAPS];
+            alignas( 16 ) float tapsR[SAMPLEREADER_SINCTAPS];
+            const int64_t i0 = i - ( SAMPLEREADER_SINCTAPS / 2 ) + 1;
+
+            for( int k = 0; k < SAMPLEREADER_SINCTAPS; k++ )
+            {
+               get( i0 + k, tapsL[k], tapsR[k] );
+            }
+
+            l = dot( tapsL, pCoeffs );
+            r = NCHANNELS == 1 ? l : dot( tapsR, pCoeffs );
+         }
+
+      private:
+         const uint8_t *m_pData;
+         int64_t m_Last;
+      };
+
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class PlanarFrames
+      \date  2026-10-17
+      \brief Access to planar float sample data. Indices outside the wave
+      are clamped to its first or last frame.
+      */
+      /*----------------------------------------------------------------------------*/
+      class PlanarFrames
+      {
+      public:
+         PlanarFrames( const float *pLeft, const float *pRight, uint32_t numSamples ) :
+            m_pLeft( pLeft ),
+            m_pRight( pRight ),
+            m_Last( (int64_t)numSamples - 1 )
+         {
+         }
+
+         inline int64_t last() const
+         {
+            return( m_Last );
+         }
+
+         inline void get( int64_t i, float &l, float &r ) const
+         {
+            i = i < 0 ? 0 : ( i > m_Last ? m_Last : i );
+            l = m_pLeft[i];
+            r = m_pRight[i];
+         }
+
+         inline void sinc( int64_t i, const float *pCoeffs, float &l, float &r ) const
+         {
+            const int64_t i0 = i - ( SAMPLEREADER_SINCTAPS / 2 ) + 1;
+
+            if( i0 >= 0 && i0 + SAMPLEREADER_SINCTAPS - 1 <= m_Last )
+            {
+               // all taps are within the wave, so they can be read in place
+               l = dot( m_pLeft + i0, pCoeffs );
+               r = m_pRight == m_pLeft ? l : dot( m_pRight + i0, pCoeffs );
+            } else
+            {
+               alignas( 16 ) float tapsL[SAMPLEREADER_SINCTAPS];
+               alignas( 16 ) float tapsR[SAMPLEREADER_SINCTAPS];
+
+               for( int k = 0; k < SAMPLEREADER_SINCTAPS; k++ )
+               {
+                  get( i0 + k, tapsL[k], tapsR[k] );
+               }
+
+               l = dot( tapsL, pCoeffs );
+               r = dot( tapsR, pCoeffs );
+            }
+         }
+
+      private:
+         const float *m_pLeft;
+         const float *m_pRight;
+         int64_t m_Last;
+      };
+
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class LoopedFrames
+      \date  2026-10-17
+      \brief Access to the frames of a looping voice. Indices outside the loop
+      are wrapped into it as described by SampleLoop, all others are passed to
+      FRAMES unchanged.
+      */
+      /*----------------------------------------------------------------------------*/
+      template<class FRAMES>
+      class LoopedFrames
+      {
+      public:
+         LoopedFrames( const FRAMES &frames, const SampleLoop &loop ) :
+            m_Frames( frames ),
+            m_Loop( loop )
+         {
+         }
+
+         inline int64_t last() const
+         {
+            return( m_Frames.last() );
+         }
+
+         inline int64_t wrap( int64_t i ) const
+         {
+            if( m_Loop.wrapAbove && i >= m_Loop.first + m_Loop.length )
+               return( m_Loop.first + ( ( i - m_Loop.first ) % m_Loop.length ) );
+            else
+            if( m_Loop.wrapBelow && i < m_Loop.first )
+               return( m_Loop.first + m_Loop.length - 1 - ( ( m_Loop.first - 1 - i ) % m_Loop.length ) );
+            else
+               return( i );
+         }
+
+         inline void get( int64_t i, float &l, float &r ) const
+         {
+            m_Frames.get( wrap( i ), l, r );
+         }
+
+         inline void sinc( int64_t i, const float *pCoeffs, float &l, float &r ) const
+         {
+            const int64_t i0 = i - ( SAMPLEREADER_SINCTAPS / 2 ) + 1;
+
+            if( wrap( i0 ) == i0 && wrap( i0 + SAMPLEREADER_SINCTAPS - 1 ) == i0 + SAMPLEREADER_SINCTAPS - 1 )
+            {
+               // no tap needs to be wrapped
+               m_Frames.sinc( i, pCoeffs, l, r );
+            } else
+            {
+               alignas( 16 ) float tapsL[SAMPLEREADER_SINCTAPS];
+               alignas( 16 ) float tapsR[SAMPLEREADER_SINCTAPS];
+
+               for( int k = 0; k < SAMPLEREADER_SINCTAPS; k++ )
+               {
+                  get( i0 + k, tapsL[k], tapsR[k] );
+               }
+
+               l = dot( tapsL, pCoeffs );
+               r = dot( tapsR, pCoeffs );
+            }
+         }
+
+      private:
+         const FRAMES &m_Frames;
+         const SampleLoop &m_Loop;
+      };
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Read n stereo frames at the given fractional sample positions, using the
+      interpolation kernel INTERPOLATION. Positions outside the wave are
+      clamped.
+      \param frames The sample data (RawFrames or PlanarFrames)
+      \param pPositions The sample positions
+      \param n The number of frames to be read
+      \param pLeft Receives the left channel's values
+      \param pRight Receives the right channel's values
+      */
+      /*----------------------------------------------------------------------------*/
+      template<int INTERPOLATION, class FRAMES>
+      inline void block( const FRAMES &frames,
+                         const double *pPositions, size_t n,
+                         float *pLeft, float *pRight )
+      {
+         const double last = (double)frames.last();
+         const SincTable *pSinc = INTERPOLATION == InterpolationSinc ? &sincTable() : nullptr;
+
+         for( size_t i = 0; i < n; i++ )
+         {
+            double pos = pPositions[i];
+            pos = pos < 0.0 ? 0.0 : ( pos > last ? last : pos );
+
+            const int64_t o = (int64_t)pos;
+            const float x = (float)( pos - (double)o );
+
+            if constexpr( INTERPOLATION == InterpolationNone )
+            {
+               frames.get( o, pLeft[i], pRight[i] );
+            } else
+            if constexpr( INTERPOLATION == InterpolationLinear )
+            {
+               float l0, r0, l1, r1;
+               frames.get( o, l0, r0 );
+               frames.get( o + 1, l1, r1 );
+               pLeft[i] = l0 + ( ( l1 - l0 ) * x );
+               pRight[i] = r0 + ( ( r1 - r0 ) * x );
+            } else
+            if constexpr( INTERPOLATION == InterpolationHermite )
+            {
+               // 4-point, 3rd-order Hermite (Catmull-Rom)
+               float lm1, rm1, l0, r0, l1, r1, l2, r2;
+               frames.get( o - 1, lm1, rm1 );
+               frames.get( o, l0, r0 );
+               frames.get( o + 1, l1, r1 );
+               frames.get( o + 2, l2, r2 );
+               pLeft[i] = hermite( x, lm1, l0, l1, l2 );
+               pRight[i] = hermite( x, rm1, r0, r1, r2 );
+            } else
+            {
+               const int phase = (int)( ( x * (float)SAMPLEREADER_SINCPHASES ) + 0.5f );
+               frames.sinc( o, pSinc->coeffs[phase], pLeft[i], pRight[i] );
+            }
+         }
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Like block(), but wraps the interpolation taps at the loop points of a
+      looping voice.
+      \param frames The sample data
+      \param pLoop The voice's loop or nullptr if it isn't looping
+      \param pPositions The sample positions
+      \param n The number of frames to be read
+      \param pLeft Receives the left channel's values
+      \param pRight Receives the right channel's values
+      */
+      /*----------------------------------------------------------------------------*/
+      template<int INTERPOLATION, class FRAMES>
+      inline void block( const FRAMES &frames, const SampleLoop *pLoop,
+                         const double *pPositions, size_t n,
+                         float *pLeft, float *pRight )
+      {
+         if( pLoop )
+            block<INTERPOLATION>( LoopedFrames<FRAMES>( frames, *pLoop ), pPositions, n, pLeft, pRight );
+         else
+            block<INTERPOLATION>( frames, pPositions, n, pLeft, pRight );
+      }
+
+      SampleValueReader valueReader( SampleFormat format, int nChannels );
+      SampleBlockReader blockReader( SampleFormat format, int nChannels, Interpolation interpolation );
+      SampleValueReader planarValueReader();
+      SampleBlockReader planarBlockReader( Interpolation interpolation );
+      SampleStreamReader streamReader( SampleFormat format, int nChannels, Interpolation interpolation );
+
+      size_t bytesPerSample( SampleFormat format );
+      std::string toString( SampleFormat format );
+
+      std::string toString( Interpolation interpolation );
+      Interpolation interpolationFromString( const std::string &interpolation );
+      std::set<Interpolation> allInterpolations();
+   }
+}
+
+#endif
@@ -24,9 +24,11 @@
 \brief This class implements the sampler engine
 */
 /*----------------------------------------------------------------------------*/
-#include <PluginProcessor.h>
-#include <PluginEditor.h>
+#include <algorithm>
+#include <libxml/parser.h>
+#include "SampleLoader.h"
 #include "SamplerEngine.h"
+#include "util.h"
 
 using namespace SamplerEngine;
 
@@ -36,13 +38,28 @@ using namespace SamplerEngine;
 Constructor
 */
 /*----------------------------------------------------------------------------*/
-Engine::Engine( PluginProcessor *pProcessor ) :
-   m_pProcessor( pProcessor )
+Engine::Engine() :
+   m_MaxVoices( SAMPLERENGINE_MAXVOICES ),
+   m_VoiceStartIndex( 0 ),
+   m_BlockSize( 0 ),
+   m_RenderSlots( 1 ),
+   m_pWorkerPool( nullptr ),
+   m_pRenderBuses( nullptr ),
+   m_RenderNumSamples( 0 ),
+   m_RenderSampleRate( 0.0 ),
+   m_RenderBpm( 0.0 ),
+   m_StateCompression( BinaryState::CompressionNone ),
+   m_EmbedSamples( true ),
+   m_SampleLoadMode( WaveFile::LoadModeRead ),
+   m_Realtime( true )
 {
    for( size_t i = 0; i < SAMPLERENGINE_NUMPARTS; i++ )
    {
       m_Parts.push_back( new Part( i, this ) );
    }
+   m_RenderParts.reserve( SAMPLERENGINE_NUMPARTS );
+
+   prepareToPlay( SAMPLERENGINE_DEFAULTBLOCKSIZE );
 }
 
 
@@ -53,6 +70,8 @@ Destructor
 /*----------------------------------------------------------------------------*/
 Engine::~Engine()
 {
+   delete m_pWorkerPool;
+
    for( size_t i = 0; i < m_Parts.size(); i++ )
    {
       delete m_Parts[i];
@@ -71,11 +90,51 @@ Process the engine.
 */
 /*----------------------------------------------------------------------------*/
 bool Engine::process( std::vector<OutputBus> &buses, double sampleRate, double bpm )
+{
+   size_t numSamples = 0;
+   for( const OutputBus &bus : buses )
+   {
+      if( bus.isValid() )
+      {
+         numSamples = bus.getNumSamples();
+         break;
+      }
+   }
+
+   return( process( buses, 0, numSamples, sampleRate, bpm ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Process a portion of the output buses. This allows for splitting a block at
+the timestamps of incoming MIDI events, so that these are applied with sample
+accuracy.
+\param buses A vector of all output buses
+\param startSample The first sample within the output buses to be rendered
+\param numSamples The number of samples to be rendered
+\param sampleRate The sample rate in Hz
+\param bpm The host's tempo in bpm
+\return true If there has been an update
+*/
+/*----------------------------------------------------------------------------*/
+bool Engine::process( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples, double sampleRate, double bpm )
 {
    bool update = false;
+
+   if( numSamples == 0 )
+      return( update );
+
+   if( m_pWorkerPool && buses.size() <= SAMPLERENGINE_MAXOUTPUTBUSES && numSamples <= m_BlockSize )
+      return( processParallel( buses, startSample, numSamples, sampleRate, bpm ) );
+
+   const ScratchBuffer &scratch = m_RenderSlots[0].getScratchBuffer();
    for( Part *pPart : m_Parts )
    {
-      update = update || pPart->process( buses, sampleRate, bpm );
+      if( pPart->process( buses, startSample, numSamples, scratch, sampleRate, bpm ) )
+      {
+         update = true;
+      }
    }
 
    return( update );
@@ -83,70 +142,277 @@ bool Engine::process( std::vector<OutputBus> &buses, double sampleRate, double b
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-Delete a specific sample from a specific part
-\param part The part number (0..15)
-\param pSample The sample
+/*! 2026-10-17
+Render the parts which have active voices in parallel on the worker pool.
+Each thread renders into its own RenderSlot, which are then mixed into the
+output buses.
+\param buses A vector of all output buses
+\param startSample The first sample within the output buses to be rendered
+\param numSamples The number of samples to be rendered
+\param sampleRate The sample rate in Hz
+\param bpm The host's tempo in bpm
+\return true If there has been an update
 */
 /*----------------------------------------------------------------------------*/
-void Engine::deleteSample( size_t part, Sample *pSample )
+bool Engine::processParallel( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples, double sampleRate, double bpm )
 {
-   m_Parts[part]->deleteSample( pSample );
+   m_RenderParts.clear();
+   for( Part *pPart : m_Parts )
+   {
+      if( pPart->hasVoices() )
+      {
+         m_RenderParts.push_back( pPart );
+      }
+   }
+
+   if( m_RenderParts.empty() )
+      return( false );
+
+   // Not worth waking up the workers
+   if( m_RenderParts.size() == 1 )
+      return( m_RenderParts[0]->process( buses, startSample, numSamples, m_RenderSlots[0].getScratchBuffer(), sampleRate, bpm ) );
+
+   for( RenderSlot &slot : m_RenderSlots )
+   {
+      slot.reset();
+   }
+
+   m_pRenderBuses = &buses;
+   m_RenderNumSamples = numSamples;
+   m_RenderSampleRate = sampleRate;
+   m_RenderBpm = bpm;
+
+   m_pWorkerPool->run( renderPart, this, m_RenderParts.size() );
+
+   bool update = false;
+   for( RenderSlot &slot : m_RenderSlots )
+   {
+      slot.mixInto( buses, startSample, numSamples );
+      update = update || slot.hasUpdate();
+   }
+
+   return( update );
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-Retrieve all samples from a specific part
-\param nPart The part number (0..15)
-\return A list of all samples of the part
+/*! 2026-10-17
+WorkerPool job: render one part into the executing thread's RenderSlot.
+\param pContext The engine
+\param nJob The index into m_RenderParts
+\param nThread The number of the executing thread
 */
 /*----------------------------------------------------------------------------*/
-std::list<Sample *> Engine::samples( size_t nPart ) const
+void Engine::renderPart( void *pContext, size_t nJob, size_t nThread )
 {
-   return( m_Parts[nPart]->samples() );
+   Engine *pEngine = (Engine *)pContext;
+   RenderSlot &slot = pEngine->m_RenderSlots[nThread];
+   std::vector<OutputBus> &buses = slot.activate( *pEngine->m_pRenderBuses, pEngine->m_RenderNumSamples );
+
+   if( pEngine->m_RenderParts[nJob]->process( buses, 0, pEngine->m_RenderNumSamples,
+                                              slot.getScratchBuffer(),
+                                              pEngine->m_RenderSampleRate, pEngine->m_RenderBpm ) )
+   {
+      slot.setUpdate();
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-\return true if the solo function is enabled
+/*! 2026-10-17
+Preallocate the scratch buffers the voices render into, so that process()
+doesn't need to allocate any memory. Must not be called concurrently with
+process().
+\param samplesPerBlock The maximum expected number of samples per block
 */
 /*----------------------------------------------------------------------------*/
-bool Engine::isSoloEnabled() const
+void Engine::prepareToPlay( size_t samplesPerBlock )
 {
-   bool bSolo = false;
+   if( samplesPerBlock == 0 )
+      samplesPerBlock = SAMPLERENGINE_DEFAULTBLOCKSIZE;
 
-   if( m_pProcessor )
+   m_BlockSize = samplesPerBlock;
+   for( RenderSlot &slot : m_RenderSlots )
    {
-      if( m_pProcessor->pluginEditor() )
-      {
-         bSolo = m_pProcessor->pluginEditor()->isSoloEnabled();
-      }
+      slot.prepare( samplesPerBlock );
    }
+}
 
-   return( bSolo );
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of threads the parts are rendered on
+*/
+/*----------------------------------------------------------------------------*/
+size_t Engine::getRenderThreads() const
+{
+   return( m_RenderSlots.size() );
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-\return A set of all samples selected by the user
+/*! 2026-10-17
+Render the parts on multiple threads. With n > 1, n - 1 worker threads are
+started in addition to the host's audio thread. With n <= 1, everything is
+rendered on the audio thread (the default). Must not be called concurrently
+with process().
+\param n The number of threads
 */
 /*----------------------------------------------------------------------------*/
-std::set<SamplerEngine::Sample *> Engine::getSelectedSamples() const
+void Engine::setRenderThreads( size_t n )
 {
-   std::set<SamplerEngine::Sample *> selSamples;
+   delete m_pWorkerPool;
+   m_pWorkerPool = nullptr;
 
-   if( m_pProcessor )
+   if( n > 1 )
    {
-      if( m_pProcessor->pluginEditor() )
-      {
-         selSamples = m_pProcessor->pluginEditor()->getSelectedSamples();
-      }
+      m_pWorkerPool = new WorkerPool( n );
    }
 
-   return( selSamples );
+   m_RenderSlots.resize( m_pWorkerPool ? m_pWorkerPool->numThreads() : 1 );
+   for( RenderSlot &slot : m_RenderSlots )
+   {
+      slot.prepare( m_BlockSize );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The compression of the sample data in saved states
+*/
+/*----------------------------------------------------------------------------*/
+BinaryState::Compression Engine::getStateCompression() const
+{
+   return( m_StateCompression );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Compressing makes saved states smaller, but saving and loading slower.
+\param compression The compression of the sample data in saved states
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::setStateCompression( BinaryState::Compression compression )
+{
+   m_StateCompression = compression;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if saved states contain the audio data of all samples
+*/
+/*----------------------------------------------------------------------------*/
+bool Engine::getEmbedSamples() const
+{
+   return( m_EmbedSamples );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Samples loaded from files can be saved as a reference (file name and hash of
+the audio data) instead of embedding the audio data, which makes saved
+states much smaller. Such states can only be loaded as long as the files
+exist unchanged.
+\param embed true to embed the audio data into saved states (the default)
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::setEmbedSamples( bool embed )
+{
+   m_EmbedSamples = embed;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return How the audio data of samples added from files is loaded
+*/
+/*----------------------------------------------------------------------------*/
+WaveFile::LoadMode Engine::getSampleLoadMode() const
+{
+   return( m_SampleLoadMode );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+WaveFile::LoadModeMap maps the files into memory instead of reading them, so
+that large sample libraries load quickly and only use memory for the parts
+which are played. Combine it with setEmbedSamples( false ), otherwise loading
+a saved state reads the audio data into memory again.
+\param mode How the audio data of samples added from files is loaded
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::setSampleLoadMode( WaveFile::LoadMode mode )
+{
+   m_SampleLoadMode = mode;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the engine renders in realtime
+*/
+/*----------------------------------------------------------------------------*/
+bool Engine::isRealtime() const
+{
+   return( m_Realtime );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+When rendering offline, voices read streamed samples directly from the file
+instead of playing silence for the parts which haven't been loaded in time.
+\param realtime false if the engine renders offline
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::setRealtime( bool realtime )
+{
+   m_Realtime = realtime;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2024-06-28
+Delete a specific sample from a specific part
+\param part The part number (0..15)
+\param pSample The sample
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::deleteSample( size_t part, Sample *pSample )
+{
+   m_Parts[part]->deleteSample( pSample );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2024-06-28
+Retrieve all samples from a specific part
+\param nPart The part number (0..15)
+\return A list of all samples of the part
+*/
+/*----------------------------------------------------------------------------*/
+std::list<Sample *> Engine::samples( size_t nPart ) const
+{
+   return( m_Parts[nPart]->samples() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pSample A sample
+\return false if the sample must not be played because the host has enabled
+the solo function and the sample isn't selected
+*/
+/*----------------------------------------------------------------------------*/
+bool Engine::isAudible( const Sample *pSample ) const
+{
+   Snapshot<const EngineHost::Selection>::Reader selection( m_Host.selection() );
+   return( EngineHost::isAudible( *selection, pSample ) );
 }
 
 
@@ -218,13 +484,13 @@ void Engine::controllerChange( size_t nPart, int ccNum, double v )
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-\param pProcessor
+/*! 2026-10-17
+\return The interface through which the host provides its state
 */
 /*----------------------------------------------------------------------------*/
-void Engine::setProcessor( PluginProcessor *pProcessor )
+EngineHost &Engine::host()
 {
-   m_pProcessor = pProcessor;
+   return( m_Host );
 }
 
 
@@ -240,10 +506,16 @@ void Engine::importPart( size_t nPart, xmlNode *pXmlPart )
    if( nPart >= SAMPLERENGINE_NUMPARTS )
       return;
 
-   Part *pPart = Part::fromXml( pXmlPart );
+   SampleLoader loader;
+   Part *pPart = Part::fromXml( pXmlPart, nullptr, &loader );
+   loader.start();
+   loader.wait();
+
    if( pPart )
    {
+      loader.insertSamples();
       pPart->setPartNum( nPart );
+      pPart->setEngine( this );
       delete m_Parts[nPart];
       m_Parts[nPart] = pPart;
    }
@@ -254,14 +526,50 @@ void Engine::importPart( size_t nPart, xmlNode *pXmlPart )
 /*! 2024-06-28
 Reconstruct a sample engine object from a previously generated XML element (see toXml()).
 \param pe The XML element
+\param pState The binary state the XML has been read from, if any
 \return Pointer to the Engine object or nullptr on error
 */
 /*----------------------------------------------------------------------------*/
-Engine *Engine::fromXml( xmlNode *peOvervoltage )
+Engine *Engine::fromXml( xmlNode *peOvervoltage, const BinaryState *pState )
 {
    if( std::string( (char*)peOvervoltage->name ) == "overvoltage" )
    {
       Engine *pEngine = new Engine();
+      SampleLoader loader;
+      std::vector<Part *> replacedParts;
+
+      for( xmlAttr *pAttr = peOvervoltage->properties; pAttr; pAttr = pAttr->next )
+      {
+         if( pAttr->type == XML_ATTRIBUTE_NODE )
+         {
+            std::string name = std::string( (char*)pAttr->name );
+            xmlChar* pValue = xmlNodeListGetString( peOvervoltage->doc, pAttr->children, 1 );
+            std::string value = std::string( (char*)pValue );
+            xmlFree( pValue );
+
+            if( name == "maxvoices" )
+            {
+               pEngine->setMaxVoices( std::stoul( value ) );
+            } else
+            if( name == "renderthreads" )
+            {
+               pEngine->setRenderThreads( std::stoul( value ) );
+            } else
+            if( name == "statecompression" )
+            {
+               pEngine->setStateCompression( BinaryState::compressionFromString( value ) );
+            } else
+            if( name == "embedsamples" )
+            {
+               pEngine->setEmbedSamples( value == "true" );
+            } else
+            if( name == "sampleloadmode" )
+            {
+               pEngine->setSampleLoadMode( WaveFile::loadModeFromString( value ) );
+            }
+         }
+      }
+
       for( xmlNode *pNode = peOvervoltage->children; pNode; pNode = pNode->next )
       {
          if( pNode->type == XML_ELEMENT_NODE )
@@ -274,13 +582,13 @@ Engine *Engine::fromXml( xmlNode *peOvervoltage )
                   {
                      if( std::string( (char*)peParts->name ) == "part" )
                      {
-                        Part *pPart = Part::fromXml( peParts );
+                        Part *pPart = Part::fromXml( peParts, pState, &loader );
                         if( pPart )
                         {
                            pPart->setEngine( pEngine );
                            if( pEngine->m_Parts[pPart->getPartNum()] )
                            {
-                              delete pEngine->m_Parts[pPart->getPartNum()];
+                              replacedParts.push_back( pEngine->m_Parts[pPart->getPartNum()] );
                            }
                            pEngine->m_Parts[pPart->getPartNum()] = pPart;
                         }
@@ -290,6 +598,18 @@ Engine *Engine::fromXml( xmlNode *peOvervoltage )
             }
          }
       }
+
+      // The samples of all parts are decoded in parallel. Parts replaced by
+      // a duplicate part number are kept until their samples are inserted.
+      loader.start();
+      loader.wait();
+      loader.insertSamples();
+
+      for( Part *pPart : replacedParts )
+      {
+         delete pPart;
+      }
+
       return( pEngine );
    } else
    {
@@ -301,17 +621,24 @@ Engine *Engine::fromXml( xmlNode *peOvervoltage )
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Create an XML element from the Engine settings.
+\param pState If not nullptr, the sample data is stored in this binary state
+rather than embedded into the XML
 \return Pointer to the new XML element
 */
 /*----------------------------------------------------------------------------*/
-xmlNode *Engine::toXml() const
+xmlNode *Engine::toXml( BinaryState *pState ) const
 {
    xmlNode *pVt = xmlNewNode( nullptr, (xmlChar *)"overvoltage" );
+   xmlNewProp( pVt, (xmlChar *)"maxvoices", (xmlChar *)stdformat( "{}", m_MaxVoices ).c_str() );
+   xmlNewProp( pVt, (xmlChar *)"renderthreads", (xmlChar *)stdformat( "{}", getRenderThreads() ).c_str() );
+   xmlNewProp( pVt, (xmlChar *)"statecompression", (xmlChar *)BinaryState::toString( m_StateCompression ).c_str() );
+   xmlNewProp( pVt, (xmlChar *)"embedsamples", (xmlChar *)( m_EmbedSamples ? "true" : "false" ) );
+   xmlNewProp( pVt, (xmlChar *)"sampleloadmode", (xmlChar *)WaveFile::toString( m_SampleLoadMode ).c_str() );
 
    xmlNode *peParts = xmlNewNode( nullptr, (xmlChar *)"parts" );
    for( size_t i = 0; i < m_Parts.size(); i++ )
    {
-      xmlNode *pePart = m_Parts[i]->toXml();
+      xmlNode *pePart = m_Parts[i]->toXml( pState );
       xmlAddChild( peParts, pePart );
    }
 
@@ -321,6 +648,75 @@ xmlNode *Engine::toXml() const
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Save the engine as a binary state (e.g. the plugin's state in a project):
+the settings as compact XML and the sample data as raw chunks, so that
+saving doesn't have to encode the sample data as text.
+\param state The binary state. It refers to the engine's sample data until
+it has been written.
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::saveState( BinaryState &state ) const
+{
+   state.setCompression( m_StateCompression );
+   state.setEmbedSamples( m_EmbedSamples );
+
+   xmlNode *pXml = toXml( &state );
+
+   xmlDoc *pDoc = xmlNewDoc( (xmlChar *)"1.0" );
+   xmlDocSetRootElement( pDoc, pXml );
+   xmlChar *pBuf;
+   int bufSize;
+   xmlDocDumpMemory( pDoc, &pBuf, &bufSize );
+   state.setXml( std::string( (char *)pBuf, (size_t)bufSize ) );
+   xmlFree( pBuf );
+   xmlFreeDoc( pDoc );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Load an engine saved with saveState() or, for older states, saved as XML
+with toXml().
+\param pData The saved state
+\param size The size of the saved state in bytes
+\return Pointer to the Engine object or nullptr on error
+*/
+/*----------------------------------------------------------------------------*/
+Engine *Engine::loadState( const void *pData, size_t size )
+{
+   BinaryState state;
+   const BinaryState *pState = nullptr;
+   const char *pXml = (const char *)pData;
+   size_t xmlSize = size;
+
+   if( BinaryState::isBinaryState( pData, size ) )
+   {
+      if( !state.read( pData, size ) )
+         return( nullptr );
+
+      pState = &state;
+      pXml = state.xml().data();
+      xmlSize = state.xml().size();
+   }
+
+   xmlDocPtr doc = xmlReadMemory( pXml, (int)xmlSize, "noname.xml", nullptr, XML_PARSE_HUGE );
+   if( !doc )
+      return( nullptr );
+
+   Engine *pEngine = nullptr;
+   xmlNode *pRoot = xmlDocGetRootElement( doc );
+   if( pRoot )
+   {
+      pEngine = fromXml( pRoot, pState );
+   }
+   xmlFreeDoc( doc );
+
+   return( pEngine );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 \param nPart The part number (0..15)
@@ -361,6 +757,93 @@ bool Engine::isPlaying( size_t nPart, const Sample *pSample ) const
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The maximum number of voices all parts may play simultaneously
+*/
+/*----------------------------------------------------------------------------*/
+size_t Engine::getMaxVoices() const
+{
+   return( m_MaxVoices );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param n The maximum number of voices all parts may play simultaneously
+*/
+/*----------------------------------------------------------------------------*/
+void Engine::setMaxVoices( size_t n )
+{
+   if( n < 1 )
+      n = 1;
+
+   m_MaxVoices = n;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of voices currently playing in all parts, not counting
+voices that have been stolen and are fading out
+*/
+/*----------------------------------------------------------------------------*/
+size_t Engine::numActiveVoices() const
+{
+   size_t n = 0;
+   for( const Part *pPart : m_Parts )
+   {
+      n += pPart->numActiveVoices();
+   }
+
+   return( n );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Steal a voice from any part in order to make room for a new voice.
+\param mode The voice stealing mode
+\param note The MIDI note number of the new voice
+\return true if a voice has been stolen
+*/
+/*----------------------------------------------------------------------------*/
+bool Engine::stealVoice( Part::VoiceStealing mode, int note )
+{
+   Voice *pBest = nullptr;
+   Part *pBestPart = nullptr;
+   for( Part *pPart : m_Parts )
+   {
+      Voice *pVoice = pPart->findVoiceToSteal( mode, note );
+      if( pVoice && Part::isBetterVoiceToSteal( mode, note, pVoice, pBest ) )
+      {
+         pBest = pVoice;
+         pBestPart = pPart;
+      }
+   }
+
+   if( pBest )
+   {
+      pBestPart->stealVoice( pBest );
+      return( true );
+   } else
+   {
+      return( false );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return A new running number for determining the age of a voice
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t Engine::nextVoiceStartIndex()
+{
+   return( m_VoiceStartIndex++ );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 \param nPart The part number (0..15)
@@ -462,3 +945,180 @@ bool OutputBus::isValid() const
    return( m_Valid );
 }
 
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param valid true if the output bus is valid
+*/
+/*----------------------------------------------------------------------------*/
+void OutputBus::setValid( bool valid )
+{
+   m_Valid = valid;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+RenderSlot::RenderSlot() :
+   m_ScratchBuffer( { nullptr, nullptr, nullptr, nullptr, nullptr, 0 } ),
+   m_Active( false ),
+   m_Update( false )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+RenderSlot::~RenderSlot()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Allocate the buffers.
+\param samplesPerBlock The maximum number of samples per block
+*/
+/*----------------------------------------------------------------------------*/
+void RenderSlot::prepare( size_t samplesPerBlock )
+{
+   m_ScratchBuffers.resize( 4 );
+   for( std::vector<float> &buf : m_ScratchBuffers )
+   {
+      buf.assign( samplesPerBlock, 0.0f );
+   }
+   m_ScratchPositions.assign( samplesPerBlock, 0.0 );
+
+   m_ScratchBuffer.pLeft = m_ScratchBuffers[0].data();
+   m_ScratchBuffer.pRight = m_ScratchBuffers[1].data();
+   m_ScratchBuffer.pLeftAmp = m_ScratchBuffers[2].data();
+   m_ScratchBuffer.pRightAmp = m_ScratchBuffers[3].data();
+   m_ScratchBuffer.pPositions = m_ScratchPositions.data();
+   m_ScratchBuffer.size = samplesPerBlock;
+
+   m_BusBuffer.assign( SAMPLERENGINE_MAXOUTPUTBUSES * 2 * samplesPerBlock, 0.0f );
+   m_Buses.clear();
+   for( size_t b = 0; b < SAMPLERENGINE_MAXOUTPUTBUSES; b++ )
+   {
+      float *pLeft = m_BusBuffer.data() + ( b * 2 * samplesPerBlock );
+      m_Buses.push_back( OutputBus( samplesPerBlock, { pLeft, pLeft + samplesPerBlock } ) );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The preallocated scratch buffers the voices render into
+*/
+/*----------------------------------------------------------------------------*/
+const ScratchBuffer &RenderSlot::getScratchBuffer() const
+{
+   return( m_ScratchBuffer );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Mark the slot as unused before a new block is rendered.
+*/
+/*----------------------------------------------------------------------------*/
+void RenderSlot::reset()
+{
+   m_Active = false;
+   m_Update = false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Prepare the slot's private output buses for rendering, unless that has
+already happened since the last reset(). They mirror the validity of the
+host's output buses and are cleared.
+\param buses The host's output buses
+\param numSamples The number of samples to be rendered
+\return The slot's private output buses
+*/
+/*----------------------------------------------------------------------------*/
+std::vector<OutputBus> &RenderSlot::activate( std::vector<OutputBus> &buses, size_t numSamples )
+{
+   if( !m_Active )
+   {
+      for( size_t b = 0; b < m_Buses.size(); b++ )
+      {
+         bool valid = b < buses.size() &&
+                      buses[b].isValid() &&
+                      buses[b].getWritePointers().size() == 2;
+         m_Buses[b].setValid( valid );
+
+         if( valid )
+         {
+            std::fill( m_Buses[b].getWritePointers()[0], m_Buses[b].getWritePointers()[0] + numSamples, 0.0f );
+            std::fill( m_Buses[b].getWritePointers()[1], m_Buses[b].getWritePointers()[1] + numSamples, 0.0f );
+         }
+      }
+      m_Active = true;
+   }
+
+   return( m_Buses );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add the slot's private output buses to the host's output buses.
+\param buses The host's output buses
+\param startSample The first sample within the host's output buses
+\param numSamples The number of samples
+*/
+/*----------------------------------------------------------------------------*/
+void RenderSlot::mixInto( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples )
+{
+   if( !m_Active )
+      return;
+
+   for( size_t b = 0; b < buses.size() && b < m_Buses.size(); b++ )
+   {
+      if( !m_Buses[b].isValid() || startSample + numSamples > buses[b].getNumSamples() )
+         continue;
+
+      for( size_t c = 0; c < 2; c++ )
+      {
+         const float *pSrc = m_Buses[b].getWritePointers()[c];
+         float *pDst = buses[b].getWritePointers()[c] + startSample;
+
+         for( size_t i = 0; i < numSamples; i++ )
+         {
+            pDst[i] += pSrc[i];
+         }
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Note that a part rendered into this slot has reported an update.
+*/
+/*----------------------------------------------------------------------------*/
+void RenderSlot::setUpdate()
+{
+   m_Update = true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if a part rendered into this slot has reported an update
+*/
+/*----------------------------------------------------------------------------*/
+bool RenderSlot::hasUpdate() const
+{
+   return( m_Update );
+}
+
@@ -27,15 +27,18 @@
 #ifndef __SAMPLERENGINE_H__
 #define __SAMPLERENGINE_H__
 
+#include "EngineHost.h"
 #include "Part.h"
 #include "Voice.h"
+#include "WorkerPool.h"
 
 #include <libxml/tree.h>
 
 #define SAMPLERENGINE_NUMLAYERS 8
 #define SAMPLERENGINE_NUMPARTS 16
-
-class PluginProcessor;
+#define SAMPLERENGINE_DEFAULTBLOCKSIZE 1024
+#define SAMPLERENGINE_MAXVOICES 256
+#define SAMPLERENGINE_MAXOUTPUTBUSES 8
 
 namespace SamplerEngine
 {
@@ -55,6 +58,7 @@ namespace SamplerEngine
       size_t getNumSamples() const;
       std::vector<float *> &getWritePointers();
       bool isValid() const;
+      void setValid( bool valid );
 
    private:
       bool m_Valid;
@@ -62,6 +66,40 @@ namespace SamplerEngine
       std::vector<float *> m_WritePointers;
    };
 
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class RenderSlot
+   \date  2026-10-17
+   The buffers owned by one rendering thread: the voices' scratch buffers and
+   a private set of output buses, which are mixed into the host's buses once
+   all threads are done.
+   */
+   /*----------------------------------------------------------------------------*/
+   class RenderSlot
+   {
+   public:
+      RenderSlot();
+      ~RenderSlot();
+
+      void prepare( size_t samplesPerBlock );
+      const ScratchBuffer &getScratchBuffer() const;
+
+      void reset();
+      std::vector<OutputBus> &activate( std::vector<OutputBus> &buses, size_t numSamples );
+      void mixInto( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples );
+      void setUpdate();
+      bool hasUpdate() const;
+
+   private:
+      std::vector<std::vector<float>> m_ScratchBuffers;
+      std::vector<double> m_ScratchPositions;
+      ScratchBuffer m_ScratchBuffer;
+      std::vector<float> m_BusBuffer;
+      std::vector<OutputBus> m_Buses;
+      bool m_Active;
+      bool m_Update;
+   };
+
    /*----------------------------------------------------------------------------*/
    /*!
    \class Engine
@@ -71,12 +109,17 @@ namespace SamplerEngine
    class Engine
    {
    public:
-      Engine( PluginProcessor *pProcessor = nullptr );
+      Engine();
       ~Engine();
 
       bool process( std::vector<OutputBus> &buses, double sampleRate, double bpm );
+      bool process( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples, double sampleRate, double bpm );
+      void prepareToPlay( size_t samplesPerBlock );
 
-      void setProcessor( PluginProcessor *pProcessor );
+      size_t getRenderThreads() const;
+      void setRenderThreads( size_t n );
+
+      EngineHost &host();
 
       Part *findPart( const Sample *pSample );
       Part *getPart( size_t nPart );
@@ -92,19 +135,52 @@ namespace SamplerEngine
       std::list<Sample *> &samples( size_t nPart );
       const std::list<Sample *> &constSamples( size_t nPart ) const;
 
-      bool isSoloEnabled() const;
-      std::set<Sample *> getSelectedSamples() const;
+      bool isAudible( const Sample *pSample ) const;
 
       bool isPlaying( size_t nPart, const Sample *pSample ) const;
 
+      size_t getMaxVoices() const;
+      void setMaxVoices( size_t n );
+      size_t numActiveVoices() const;
+      bool stealVoice( Part::VoiceStealing mode, int note );
+      uint64_t nextVoiceStartIndex();
+
       void importPart( size_t nPart, xmlNode *pXmlPart );
 
-      xmlNode *toXml() const;
-      static Engine *fromXml( xmlNode *peOvervoltage );
+      xmlNode *toXml( BinaryState *pState = nullptr ) const;
+      static Engine *fromXml( xmlNode *peOvervoltage, const BinaryState *pState = nullptr );
+      void saveState( BinaryState &state ) const;
+      static Engine *loadState( const void *pData, size_t size );
+      BinaryState::Compression getStateCompression() const;
+      void setStateCompression( BinaryState::Compression compression );
+      bool getEmbedSamples() const;
+      void setEmbedSamples( bool embed );
+      WaveFile::LoadMode getSampleLoadMode() const;
+      void setSampleLoadMode( WaveFile::LoadMode mode );
+      bool isRealtime() const;
+      void setRealtime( bool realtime );
+
+   private:
+      bool processParallel( std::vector<OutputBus> &buses, size_t startSample, size_t numSamples, double sampleRate, double bpm );
+      static void renderPart( void *pContext, size_t nJob, size_t nThread );
 
    private:
-      PluginProcessor *m_pProcessor;
+      EngineHost m_Host;
       std::vector<Part *> m_Parts;
+      size_t m_MaxVoices;
+      uint64_t m_VoiceStartIndex;
+      size_t m_BlockSize;
+      std::vector<RenderSlot> m_RenderSlots;
+      WorkerPool *m_pWorkerPool;
+      std::vector<Part *> m_RenderParts;
+      std::vector<OutputBus> *m_pRenderBuses;
+      size_t m_RenderNumSamples;
+      double m_RenderSampleRate;
+      double m_RenderBpm;
+      BinaryState::Compression m_StateCompression;
+      bool m_EmbedSamples;
+      WaveFile::LoadMode m_SampleLoadMode;
+      bool m_Realtime;
    };
 }
 
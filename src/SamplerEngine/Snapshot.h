@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file Snapshot.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class Snapshot.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include <atomic>
+#include <thread>
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class Snapshot
+   \date  2026-10-17
+   A value which is replaced as a whole by a single writer thread and read by
+   any number of threads. Readers never block or allocate: they merely
+   register themselves and load the current pointer. The writer swaps in the
+   new value and deletes (or hands back) the old one once no reader can still
+   be using it. Readers register with one of two epochs, which the writer
+   flips on each swap, so it only waits for the readers which may have
+   loaded the old value and never for the ones which arrive later. Use a
+   const T for values which are immutable once published.
+   */
+   /*----------------------------------------------------------------------------*/
+   template<class T>
+   class Snapshot
+   {
+   public:
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class Reader
+      \date  2026-10-17
+      Access to the current value for as long as the Reader exists.
+      */
+      /*----------------------------------------------------------------------------*/
+      class Reader
+      {
+      public:
+         Reader( const Snapshot &snapshot ) :
+            m_Snapshot( snapshot )
+         {
+            // If the epoch flips before the registration is complete, the
+            // writer may not wait for it, so register again with the new one
+            for( ;; )
+            {
+               m_Epoch = m_Snapshot.m_Epoch.load();
+               m_Snapshot.m_NumReaders[m_Epoch].fetch_add( 1 );
+               if( m_Snapshot.m_Epoch.load() == m_Epoch )
+                  break;
+               m_Snapshot.m_NumReaders[m_Epoch].fetch_sub( 1 );
+            }
+
+            m_pValue = m_Snapshot.m_pValue.load();
+         }
+
+         ~Reader()
+         {
+            m_Snapshot.m_NumReaders[m_Epoch].fetch_sub( 1 );
+         }
+
+         T *operator->() const
+         {
+            return( m_pValue );
+         }
+
+         T &operator*() const
+         {
+            return( *m_pValue );
+         }
+
+         T *get() const
+         {
+            return( m_pValue );
+         }
+
+      private:
+         Reader( const Reader & ) = delete;
+         Reader &operator=( const Reader & ) = delete;
+
+         const Snapshot &m_Snapshot;
+         unsigned int m_Epoch;
+         T *m_pValue;
+      };
+
+      Snapshot( T *pValue ) :
+         m_pValue( pValue ),
+         m_Epoch( 0 )
+      {
+         m_NumReaders[0].store( 0 );
+         m_NumReaders[1].store( 0 );
+      }
+
+      ~Snapshot()
+      {
+         delete m_pValue.load();
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Replace the value. Must only be called from one thread at a time. Waits
+      until no reader uses the previous value anymore.
+      \param pValue The new value, ownership is taken over
+      */
+      /*----------------------------------------------------------------------------*/
+      void publish( T *pValue )
+      {
+         delete exchange( pValue );
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      Replace the value without deleting the previous one, e.g. to have it
+      freed on another thread. Must only be called from one thread at a time.
+      Waits until no reader uses the previous value anymore.
+      \param pValue The new value, ownership is taken over
+      \return The previous value, ownership is passed to the caller
+      */
+      /*----------------------------------------------------------------------------*/
+      T *exchange( T *pValue )
+      {
+         T *pOld = m_pValue.exchange( pValue );
+
+         // A reader which loaded pOld has registered itself with the current
+         // epoch before the exchange. Readers registering after the flip
+         // can only load the new value.
+         unsigned int epoch = m_Epoch.load();
+         m_Epoch.store( 1 - epoch );
+         while( m_NumReaders[epoch].load() != 0 )
+         {
+            std::this_thread::yield();
+         }
+
+         return( pOld );
+      }
+
+      /*----------------------------------------------------------------------------*/
+      /*! 2026-10-17
+      \return The current value. Without a Reader, this is only safe on the
+      thread which publishes.
+      */
+      /*----------------------------------------------------------------------------*/
+      T *current() const
+      {
+         return( m_pValue.load() );
+      }
+
+   private:
+      Snapshot( const Snapshot & ) = delete;
+      Snapshot &operator=( const Snapshot & ) = delete;
+
+      std::atomic<T *> m_pValue;
+      std::atomic<unsigned int> m_Epoch;
+      mutable std::atomic<int> m_NumReaders[2];
+   };
+}
+
+#endif
@@ -25,6 +25,7 @@
 */
 /*----------------------------------------------------------------------------*/
 #include <math.h>
+#include <algorithm>
 #include <util.h>
 #include "Voice.h"
 #include "Part.h"
@@ -37,70 +38,133 @@ using namespace SamplerEngine;
 Constructor
 */
 /*----------------------------------------------------------------------------*/
-Voice::Voice( const Part *pPart, const Sample *pSample, int note, int velocity ) :
-   m_pPart( pPart ),
-   m_pSample( pSample ),
-   m_pAEG( nullptr ),
-   m_pEG2( nullptr ),
-   m_pFilter( nullptr ),
-   m_NoteIsOn( true ),
-   m_Note( note ),
+Voice::Voice() :
+   m_pPart( nullptr ),
+   m_pSample( nullptr ),
+   m_pReadBlock( nullptr ),
+   m_pStream( nullptr ),
+   m_NoteIsOn( false ),
+   m_Note( 0 ),
    m_PitchMod( 0.0 ),
    m_PanMod( 0.0 ),
    m_AmpMod( 0.0 ),
-   m_Velocity( velocity ),
+   m_Velocity( 0 ),
    m_Ofs( 0.0 ),
-   m_nSample( 0 )
+   m_HasLooped( false ),
+   m_Speed( 0.0 ),
+   m_SpeedStep( 0.0 ),
+   m_HasSpeed( false ),
+   m_Pitchbend( 0.0 ),
+   m_ModStepSamples( 1 ),
+   m_SamplesToModStep( 0 ),
+   m_RandomBipolar( 0.0 ),
+   m_StartIndex( 0 ),
+   m_Stolen( false ),
+   m_FadeOutGain( 1.0f )
 {
+   // Make sure that copying the LFO settings never needs to allocate memory
+   for( size_t i = 0; i < NUM_LFO; i++ )
+   {
+      m_LFOs[i].getCustomRef().reserve( LFO_MAXCUSTOMVALUES );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2024-06-28
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+Voice::~Voice()
+{
+   stop();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+(Re-)initialize the voice and trigger its envelopes and LFOs.
+\param pPart The part the voice belongs to
+\param pSample The sample to be played
+\param note The MIDI note number
+\param velocity The MIDI velocity
+\param startIndex A running number used to determine the age of the voice
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::start( const Part *pPart, const Sample *pSample, int note, int velocity, uint64_t startIndex )
+{
+   stop();
+
+   m_pPart = pPart;
+   m_pSample = pSample;
+   m_pReadBlock = pSample->getWave()->getBlockReader( pPart->getInterpolation() );
+   m_NoteIsOn = true;
+   m_Note = note;
+   m_PitchMod = 0.0;
+   m_PanMod = 0.0;
+   m_AmpMod = 0.0;
+   m_Velocity = velocity;
+   m_Ofs = 0.0;
+   m_HasLooped = false;
+   m_Speed = 0.0;
+   m_SpeedStep = 0.0;
+   m_HasSpeed = false;
+   m_Pitchbend = 0.0;
+   m_SamplesToModStep = 0;
+   m_StartIndex = startIndex;
+   m_Stolen = false;
+   m_FadeOutGain = 1.0f;
+
    if( pSample->getReverse() )
    {
       m_Ofs = (double)pSample->getWave()->numSamples() - 1;
    }
 
-   m_pAEG = new ENV( *pSample->getAEG() );
-   m_pAEG->noteOn();
+   const WaveFile *pWave = pSample->getWave();
+   if( pWave->isStreamed() )
+   {
+      // Without a free stream, only the resident parts of the wave are played
+      m_pStream = DiskStreamer::instance().acquire( pWave->poolData(), pWave->frameSize(), pWave->numSamples(), m_Ofs, pSample->getReverse() );
+   }
+
+   m_AEG.getSettings( *pSample->getAEG() );
+   m_AEG.reset();
+   m_AEG.noteOn();
 
-   m_pEG2 = new ENV( *pSample->getEG2() );
-   m_pEG2->noteOn();
+   m_EG2.getSettings( *pSample->getEG2() );
+   m_EG2.reset();
+   m_EG2.noteOn();
 
-   for( size_t i = 0; i < pSample->getNumLFOs(); i++ )
+   for( size_t i = 0; i < NUM_LFO; i++ )
    {
       if( pSample->getLFO( i ) )
       {
-         LFO *pLFO = new LFO( *pSample->getLFO( i ) );
-         pLFO->noteOn();
-         m_LFOs.push_back( pLFO );
-      } else
-      {
-         m_LFOs.push_back( nullptr );
+         m_LFOs[i].getSettings( *pSample->getLFO( i ) );
       }
+      m_LFOs[i].reset();
+      m_LFOs[i].noteOn();
    }
 
-   m_pFilter = new Filter( *pSample->getFilter() );
+   m_Filter.getSettings( *pSample->getFilter() );
+   m_Filter.reset();
 
    m_RandomBipolar = util::randomValue( -1.0, 1.0 );
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-Destructor
+/*! 2026-10-17
+Called when the voice is returned to the voice pool. Releases its disk
+stream, if any.
 */
 /*----------------------------------------------------------------------------*/
-Voice::~Voice()
+void Voice::stop()
 {
-   delete m_pAEG;
-   delete m_pEG2;
-   delete m_pFilter;
-
-   for( size_t i = 0; i < m_LFOs.size(); i++ )
+   if( m_pStream )
    {
-      if( m_LFOs[i] )
-      {
-         delete m_LFOs[i];
-      }
+      DiskStreamer::instance().release( m_pStream );
+      m_pStream = nullptr;
    }
-   m_LFOs.clear();
 }
 
 
@@ -115,19 +179,75 @@ void Voice::noteOff()
       return;
 
    m_NoteIsOn = false;
-   m_pAEG->noteOff();
-   m_pEG2->noteOff();
+   m_AEG.noteOff();
+   m_EG2.noteOff();
 
-   for( size_t i = 0; i < m_LFOs.size(); i++ )
+   for( size_t i = 0; i < NUM_LFO; i++ )
    {
-      if( m_LFOs[i] )
-      {
-         m_LFOs[i]->noteOff();
-      }
+      m_LFOs[i].noteOff();
    }
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true as long as the note hasn't been released
+*/
+/*----------------------------------------------------------------------------*/
+bool Voice::isNoteOn() const
+{
+   return( m_NoteIsOn );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+The voice has been chosen to make room for a new voice. It will be faded out
+within VOICE_STEAL_FADEOUT_SECS and is then stopped.
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::steal()
+{
+   m_Stolen = true;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the voice has been stolen and is currently fading out
+*/
+/*----------------------------------------------------------------------------*/
+bool Voice::isStolen() const
+{
+   return( m_Stolen );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The current amplitude of the voice (0..1) as determined by the AEG
+*/
+/*----------------------------------------------------------------------------*/
+double Voice::getAmplitude() const
+{
+   if( m_pSample && m_pSample->getPlayMode() == Sample::PlayModeShot )
+      return( m_FadeOutGain );
+   else
+      return( m_AEG.getValue() * m_FadeOutGain );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The running number the voice has been started with
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t Voice::getStartIndex() const
+{
+   return( m_StartIndex );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 \return The MIDI note number
@@ -183,12 +303,14 @@ bool Voice::handleLoop()
          if( m_Ofs >= pWav->loopEnd() )
          {
             m_Ofs -= pWav->loopEnd() - pWav->loopStart();
+            m_HasLooped = true;
          }
       } else
       {
          if( m_Ofs <= pWav->loopStart() )
          {
             m_Ofs += pWav->loopEnd() - pWav->loopStart();
+            m_HasLooped = true;
          }
       }
    }
@@ -198,140 +320,264 @@ bool Voice::handleLoop()
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-Retrieve the modulation source's value
-\param modSrc The modulation souce
-\param defaultValue The default value in case the modulation sources value cannot be determined
-\return The modulation source value
+/*! 2026-10-17
+Determine how the interpolation taps wrap at the loop points. Taps behind
+the loop end continue at the loop start when playing forwards, and vice
+versa when playing backwards. Taps on the other side of the loop are only
+wrapped once the voice has passed the loop point, as before that the wave
+is played up to the loop.
+\param loop Receives the loop
+\return &loop or nullptr if the voice isn't looping
 */
 /*----------------------------------------------------------------------------*/
-double Voice::getModValue( ModMatrix::ModSrc modSrc, double defaultValue ) const
+const SampleLoop *Voice::getLoop( SampleLoop &loop ) const
 {
-   if( modSrc == ModMatrix::ModSrc_AEG )
-      return( m_pAEG->getValue() );
-   else
-   if( modSrc == ModMatrix::ModSrc_EG2 )
-      return( m_pEG2->getValue() );
-   else
-   if( modSrc == ModMatrix::ModSrc_LFO1 )
-      return( m_LFOs[0]->getValue() );
-   else
-   if( modSrc == ModMatrix::ModSrc_LFO2 )
-      return( m_LFOs[1]->getValue() );
-   else
-   if( modSrc == ModMatrix::ModSrc_LFO3 )
-      return( m_LFOs[2]->getValue() );
-   else
-   if( modSrc == ModMatrix::ModSrc_ModWheel )
-      return( m_pPart->getController( 1 ) );
-   else
-   if( modSrc == ModMatrix::ModSrc_Velocity )
-      return( (double)m_Velocity / 127.0f );
-   else
-   if( modSrc == ModMatrix::ModSrc_AbsNote )
-      return( (double)m_Note / 127.0f );
-   else
-   if( modSrc == ModMatrix::ModSrc_RelNote )
-      return( 2.0 * (double)( m_Note - m_pSample->getMinNote() ) / (double)( m_pSample->getMaxNote() - m_pSample->getMinNote() ) );
-   else
-   if( modSrc == ModMatrix::ModSrc_RandomUnipolar )
-      return( ( m_RandomBipolar + 1.0 ) / 2.0 );
-   else
-   if( modSrc == ModMatrix::ModSrc_RandomBipolar )
-      return( m_RandomBipolar );
-   else
-   if( modSrc == ModMatrix::ModSrc_Gate )
-      return( m_NoteIsOn ? 1.0 : 0.0 );
-   else
-   if( modSrc == ModMatrix::ModSrc_IsWithinLoop )
+   const WaveFile *pWav = m_pSample->getWave();
+   Sample::PlayMode pm = m_pSample->getPlayMode();
+
+   if( ( ( pm != Sample::PlayModeLoop ) && ( pm != Sample::PlayModeLoopUntilRelease ) ) ||
+       ( pWav->loopEnd() <= pWav->loopStart() ) )
+      return( nullptr );
+
+   // The positions played are loopStart .. loopEnd - 1 when playing forwards
+   // and loopStart + 1 .. loopEnd when playing backwards, see handleLoop()
+   loop.length = (int64_t)pWav->loopEnd() - (int64_t)pWav->loopStart();
+   if( !m_pSample->getReverse() )
+   {
+      loop.first = pWav->loopStart();
+      loop.wrapAbove = true;
+      loop.wrapBelow = m_HasLooped;
+   } else
+   {
+      loop.first = (int64_t)pWav->loopStart() + 1;
+      loop.wrapAbove = m_HasLooped;
+      loop.wrapBelow = true;
+   }
+
+   return( &loop );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Retrieve the values of the modulation sources.
+\param pValues Receives MODMATRIX_NUMSRC values, indexed by ModMatrix::ModSrc.
+ModSrc_None is set to 1.0, so that it is neutral when used as a modifier.
+\param usedSources A bit mask of the sources to be determined, see
+ModMatrix::Routing::usedSources(). The other values are set to 0.0.
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::getModValues( double *pValues, uint32_t usedSources ) const
+{
+   for( size_t i = 0; i < MODMATRIX_NUMSRC; i++ )
+   {
+      pValues[i] = 0.0;
+   }
+
+   pValues[ModMatrix::ModSrc_None] = 1.0;
+   pValues[ModMatrix::ModSrc_AEG] = m_AEG.getValue();
+   pValues[ModMatrix::ModSrc_EG2] = m_EG2.getValue();
+   pValues[ModMatrix::ModSrc_LFO1] = m_LFOs[0].getValue();
+   pValues[ModMatrix::ModSrc_LFO2] = m_LFOs[1].getValue();
+   pValues[ModMatrix::ModSrc_LFO3] = m_LFOs[2].getValue();
+   pValues[ModMatrix::ModSrc_Velocity] = (double)m_Velocity / 127.0f;
+   pValues[ModMatrix::ModSrc_AbsNote] = (double)m_Note / 127.0f;
+   pValues[ModMatrix::ModSrc_RandomUnipolar] = ( m_RandomBipolar + 1.0 ) / 2.0;
+   pValues[ModMatrix::ModSrc_RandomBipolar] = m_RandomBipolar;
+   pValues[ModMatrix::ModSrc_Gate] = m_NoteIsOn ? 1.0 : 0.0;
+
+   // Sources which need more than a member access are only determined when used
+   if( usedSources & ( 1u << ModMatrix::ModSrc_ModWheel ) )
+   {
+      pValues[ModMatrix::ModSrc_ModWheel] = m_pPart->getController( 1 );
+   }
+
+   if( usedSources & ( 1u << ModMatrix::ModSrc_RelNote ) )
+   {
+      pValues[ModMatrix::ModSrc_RelNote] = 2.0 * (double)( m_Note - m_pSample->getMinNote() ) / (double)( m_pSample->getMaxNote() - m_pSample->getMinNote() );
+   }
+
+   if( usedSources & ( 1u << ModMatrix::ModSrc_IsWithinLoop ) )
    {
       const WaveFile *pWav = m_pSample->getWave();
       if( m_Ofs >= pWav->loopStart() && m_Ofs < pWav->loopEnd() )
-         return( 1.0 );
-      else
-         return( 0.0 );
-   } else
-      return( defaultValue );
+         pValues[ModMatrix::ModSrc_IsWithinLoop] = 1.0;
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
-Handle the modulations
+Evaluate the modulation matrix and advance the envelopes and LFOs by one
+control-rate step of m_ModStepSamples samples.
 \param sampleRate The sample rate in Hz
 \param bpm The host's tempo in bpm
 */
 /*----------------------------------------------------------------------------*/
-bool Voice::handleModulations( double sampleRate, double bpm )
+void Voice::handleModulations( double sampleRate, double bpm )
 {
-   bool modsUpdated = false;
+   double srcValues[MODMATRIX_NUMSRC];
+   double destValues[MODMATRIX_NUMDEST];
+   {
+      Snapshot<const ModMatrix::Routing>::Reader routing( m_pSample->getModMatrix()->routing() );
+      getModValues( srcValues, routing->usedSources() );
+      routing->evaluate( srcValues, destValues );
+   }
+
+   // Destinations without a route are reset, so that disabling a slot
+   // doesn't leave its last value applied
+   m_Filter.setCutoffMod( destValues[ModMatrix::ModDest_FilterCutoff] );
+   m_Filter.setResonanceMod( destValues[ModMatrix::ModDest_FilterResonance] );
+   m_PitchMod = destValues[ModMatrix::ModDest_Pitch];
+   m_PanMod = destValues[ModMatrix::ModDest_Pan];
+   m_AmpMod = destValues[ModMatrix::ModDest_Amp];
 
-   if( m_nSample % MODSTEP_SAMPLES == 0 )
+   double secs = (double)m_ModStepSamples / sampleRate;
+
+   m_AEG.step( secs, bpm );
+   m_EG2.step( secs, bpm );
+
+   for( size_t i = 0; i < NUM_LFO; i++ )
    {
-      std::map<ModMatrix::ModDest, double> modValues;
+      m_LFOs[i].step( secs, bpm );
+   }
+}
 
-      for( size_t nSlot = 0; nSlot < m_pSample->getModMatrix()->numSlots(); nSlot++ )
-      {
-         ModMatrix::ModSlot *pSlot = m_pSample->getModMatrix()->getSlot( nSlot );
-         bool isEnabled = pSlot->isEnabled();
-         ModMatrix::ModSrc modSrc = pSlot->getSrc();
-         ModMatrix::ModSrc modSrc2 = pSlot->getMod();
-         ModMatrix::ModDest modDest = pSlot->getDest();
-         if( isEnabled && modSrc != ModMatrix::ModSrc_None && modDest != ModMatrix::ModDest_None )
-         {
-            ModMatrix::ModDestInfo modDestInfo = modDest;
-            double modVal = getModValue( modSrc, 0.0 );
-            double modAmount = pSlot->getAmount();
-            double modVal2 = getModValue( modSrc2, 1.0 );
-            modVal = modVal * modVal2 * modAmount;
 
-            ModMatrix::MathFunc mathFunc = pSlot->getMathFunc();
-            modVal = ModMatrix::calc( mathFunc, modVal );
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Count the leading steps 0, 1, 2, ... for which a monotonic condition holds.
+\param maxSteps The maximum number of steps to be counted
+\param isInside The condition, which must not become true again once it failed
+\return The number of steps (0..maxSteps)
+*/
+/*----------------------------------------------------------------------------*/
+template<typename COND>
+static size_t countSteps( size_t maxSteps, COND isInside )
+{
+   size_t lo = 0;
+   size_t hi = maxSteps;
+   while( lo < hi )
+   {
+      size_t mid = lo + ( hi - lo ) / 2;
+      if( isInside( mid ) )
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
 
-            if( modValues.find( modDest ) != modValues.end() )
-               modValues[modDest] += modVal;
-            else
-               modValues[modDest] = modVal;
-         }
-      }
+   return( lo );
+}
 
-      for( auto mod : modValues )
-      {
-         ModMatrix::ModDest modDest = mod.first;
-         double modVal = mod.second;
-
-         if( modDest == ModMatrix::ModDest_FilterCutoff )
-            m_pFilter->setCutoffMod( modVal );
-         else
-         if( modDest == ModMatrix::ModDest_FilterResonance )
-            m_pFilter->setResonanceMod( modVal );
-         else
-         if( modDest == ModMatrix::ModDest_Pitch )
-            m_PitchMod = modVal;
-         else
-         if( modDest == ModMatrix::ModDest_Pan )
-            m_PanMod = modVal;
-         else
-         if( modDest == ModMatrix::ModDest_Amp )
-            m_AmpMod = modVal;
-      }
 
-      double secs = (double)MODSTEP_SAMPLES / sampleRate;
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Calculate a sample position within a segment. The speed changes by speedStep
+per sample, so that audio-rate pitch modulation follows a linear ramp.
+\param ofs The position of the segment's first sample
+\param speed The speed before the segment's first sample
+\param speedStep The change of the speed per sample
+\param i The sample within the segment
+\return The sample position
+*/
+/*----------------------------------------------------------------------------*/
+static inline double segmentPosition( double ofs, double speed, double speedStep, size_t i )
+{
+   double k = (double)i;
+   return( ofs + k * speed + 0.5 * k * ( k + 1.0 ) * speedStep );
+}
 
-      m_pAEG->step( secs, bpm );
-      m_pEG2->step( secs, bpm );
 
-      for( size_t i = 0; i < m_LFOs.size(); i++ )
-      {
-         m_LFOs[i]->step( secs, bpm );
-      }
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Determine the length of the next segment, i.e. the number of samples that
+can be rendered without any per-sample decisions: up to the next control-rate
+step, the next loop point or end of the wave, or the end of the steal fade out.
+handleLoop() must have been called for the current position.
+\param maxLength The maximum length of the segment
+\param fadeOutStep The decrement of the fade out gain per sample
+\return The length of the segment (1..maxLength)
+*/
+/*----------------------------------------------------------------------------*/
+size_t Voice::segmentLength( size_t maxLength, float fadeOutStep ) const
+{
+   size_t n = std::min( maxLength, m_SamplesToModStep );
+
+   // The conditions use exactly the arithmetic of renderSegment(), so that
+   // rounding can never move a position across a boundary. The positions
+   // are monotonic, as the speed never changes its sign.
+   const WaveFile *pWav = m_pSample->getWave();
+   Sample::PlayMode pm = m_pSample->getPlayMode();
+   const double ofs = m_Ofs;
+   const double speed = m_Speed;
+   const double speedStep = m_SpeedStep;
 
-      modsUpdated = true;
+   if( ( pm == Sample::PlayModeStandard ) ||
+       ( pm == Sample::PlayModeShot ) )
+   {
+      const double numSamples = (double)pWav->numSamples();
+      n = countSteps( n, [=]( size_t i ) { double pos = segmentPosition( ofs, speed, speedStep, i ); return( pos < numSamples && pos >= 0 ); } );
+   } else
+   if( !m_pSample->getReverse() )
+   {
+      const double loopEnd = (double)pWav->loopEnd();
+      n = countSteps( n, [=]( size_t i ) { return( segmentPosition( ofs, speed, speedStep, i ) < loopEnd ); } );
+   } else
+   {
+      const double loopStart = (double)pWav->loopStart();
+      n = countSteps( n, [=]( size_t i ) { return( segmentPosition( ofs, speed, speedStep, i ) > loopStart ); } );
    }
 
-   m_nSample++;
+   if( fadeOutStep > 0.0f )
+   {
+      const float fadeOutGain = m_FadeOutGain;
+      n = countSteps( n, [=]( size_t i ) { return( fadeOutGain - (float)i * fadeOutStep > 0.0f ); } );
+   }
 
-   return( modsUpdated );
+   // The current position has already been handled, so at least one sample
+   // is always rendered
+   return( std::max( n, (size_t)1 ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Render the sample positions and amplitudes of a segment and advance the
+voice. The loop is free of branches so that the compiler can vectorize it.
+\param pPositions Receives the sample positions
+\param pLeftAmp Receives the left channel's amplitudes
+\param pRightAmp Receives the right channel's amplitudes
+\param n The length of the segment
+\param velocity The velocity gain
+\param lAmp The left channel's amplitude
+\param rAmp The right channel's amplitude
+\param fadeOutStep The decrement of the fade out gain per sample
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::renderSegment( double *pPositions, float *pLeftAmp, float *pRightAmp, size_t n,
+                           float velocity, float lAmp, float rAmp, float fadeOutStep )
+{
+   const double ofs = m_Ofs;
+   const double speed = m_Speed;
+   const double speedStep = m_SpeedStep;
+   const float fadeOutGain = m_FadeOutGain;
+
+   for( size_t i = 0; i < n; i++ )
+   {
+      pPositions[i] = segmentPosition( ofs, speed, speedStep, i );
+   }
+
+   for( size_t i = 0; i < n; i++ )
+   {
+      float gain = ( fadeOutGain - (float)i * fadeOutStep ) * velocity;
+      pLeftAmp[i] = gain * lAmp;
+      pRightAmp[i] = gain * rAmp;
+   }
+
+   m_Ofs = segmentPosition( ofs, speed, speedStep, n );
+   m_Speed = speed + (double)n * speedStep;
+   m_FadeOutGain = fadeOutGain - (float)n * fadeOutStep;
+   m_SamplesToModStep -= n;
 }
 
 
@@ -361,32 +607,23 @@ void Voice::getLRAmp( double &lAmp, double &rAmp ) const
    rAmp = getRightAmp( panning ) * m_pSample->getGain();
    if( m_pSample->getPlayMode() != Sample::PlayModeShot )
    {
-      lAmp *= m_pAEG->getValue();
-      rAmp *= m_pAEG->getValue();
+      lAmp *= m_AEG.getValue();
+      rAmp *= m_AEG.getValue();
    }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-06-28
-Process the voice.
-\param pL Pointer to the left channel's sample data
-\param pR Pointer to the right channel's sample data
+/*! 2026-10-17
 \param sampleRate The sample rate in Hz
-\param bpm The host's tempo in bpm
-\return true on success
+\return The playback speed in samples per output sample, taking into account
+the note, pitchbend and pitch modulation. Negative when playing backwards.
 */
 /*----------------------------------------------------------------------------*/
-bool Voice::process( float *pL, float *pR, size_t nSamples, double sampleRate, double bpm )
+double Voice::getSpeed( double sampleRate ) const
 {
-   std::vector<float> left( nSamples );
-   std::vector<float> right( nSamples );
-
-   float *const pLeft = left.data();
-   float *const pRight = right.data();
-
    double keytrack = (double)m_pSample->getKeytrack() / 100.0;
-   double pitchbend = m_pPart->getPitchbend() * m_pSample->getPitchbendRange();;
+   double pitchbend = m_pPart->getPitchbend() * m_pSample->getPitchbendRange();
    double noteOfs = m_PitchMod + pitchbend;
    double f = (double)m_pSample->getWave()->sampleRate() *
       pow( 2.0,
@@ -398,54 +635,241 @@ bool Voice::process( float *pL, float *pR, size_t nSamples, double sampleRate, d
       f = -f;
    }
 
-   double relSpeed = f / sampleRate;
+   return( f / sampleRate );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Update the playback speed after a modulation step. At audio rate, the speed
+moves linearly to the new value across the following modulation step,
+otherwise it changes right away.
+\param sampleRate The sample rate in Hz
+\param audioRate true if the pitch is modulated at audio rate
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::updateSpeed( double sampleRate, bool audioRate )
+{
+   double speed = getSpeed( sampleRate );
+
+   if( audioRate && m_HasSpeed )
+   {
+      m_SpeedStep = ( speed - m_Speed ) / (double)m_ModStepSamples;
+   } else
+   {
+      m_Speed = speed;
+      m_SpeedStep = 0.0;
+   }
+
+   m_HasSpeed = true;
+   m_Pitchbend = m_pPart->getPitchbend();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Apply a change of the part's pitch bend right away instead of at the next
+modulation step. The speed and, at audio rate, its ramp are scaled by the
+change, so that the pitch modulation keeps its course.
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::updatePitchbend()
+{
+   const double pitchbend = m_pPart->getPitchbend();
+   if( !m_HasSpeed || pitchbend == m_Pitchbend )
+      return;
+
+   const double ratio = pow( 2.0, ( pitchbend - m_Pitchbend ) * m_pSample->getPitchbendRange() / 12.0 );
+   m_Speed *= ratio;
+   m_SpeedStep *= ratio;
+   m_Pitchbend = pitchbend;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2024-06-28
+Process the voice.
+\param pL Pointer to the left channel's sample data
+\param pR Pointer to the right channel's sample data
+\param nSamples The number of samples to be rendered
+\param scratch Preallocated scratch buffers to render into
+\param sampleRate The sample rate in Hz
+\param bpm The host's tempo in bpm
+\return true on success
+*/
+/*----------------------------------------------------------------------------*/
+bool Voice::process( float *pL, float *pR, size_t nSamples,
+                     const ScratchBuffer &scratch,
+                     double sampleRate, double bpm )
+{
+   if( scratch.size == 0 )
+      return( false );
+
+   float *const pScratchLeft = scratch.pLeft;
+   float *const pScratchRight = scratch.pRight;
+   float *const pLeftAmp = scratch.pLeftAmp;
+   float *const pRightAmp = scratch.pRightAmp;
+   double *const pPositions = scratch.pPositions;
+   const size_t scratchSize = scratch.size;
+
    float velocity = (float)m_Velocity / 127.0f;
+   float fadeOutStep = m_Stolen ? (float)( 1.0 / ( VOICE_STEAL_FADEOUT_SECS * sampleRate ) ) : 0.0f;
+   const bool audioRatePitch = m_pPart->isAudioRateModulation( ModMatrix::ModDest_Pitch );
+   const bool audioRateCutoff = m_pPart->isAudioRateModulation( ModMatrix::ModDest_FilterCutoff );
+
+   // The modulation rate is kept in Hz, so the step length depends on the
+   // sample rate
+   m_ModStepSamples = std::max( (size_t)1, (size_t)lround( sampleRate / m_pPart->getModulationRate() ) );
+   m_SamplesToModStep = std::min( m_SamplesToModStep, m_ModStepSamples );
+
+   // MIDI events are applied between sub-blocks, so a pitch bend must not
+   // wait for the next modulation step
+   updatePitchbend();
+
+   // The wave's storage mode or the part's interpolation may have been
+   // changed since the last block
+   m_pReadBlock = m_pSample->getWave()->getBlockReader( m_pPart->getInterpolation() );
+   if( !m_pReadBlock )
+      return( false );
 
-   m_pFilter->getSettings( *m_pSample->getFilter() );
-   m_pAEG->getSettings( *m_pSample->getAEG() );
-   m_pEG2->getSettings( *m_pSample->getEG2() );
-   for( size_t i = 0; i < m_LFOs.size(); i++ )
+   // Streamed waves are read directly from the file when rendering offline
+   SampleStreamReader pReadStream = nullptr;
+   if( m_pSample->getWave()->isStreamed() && m_pPart->isRealtime() )
    {
-      m_LFOs[i]->getSettings( *m_pSample->getLFO( i ) );
+      pReadStream = m_pSample->getWave()->getStreamReader( m_pPart->getInterpolation() );
+      if( !pReadStream )
+         return( false );
+   }
+
+   m_Filter.getSettings( *m_pSample->getFilter() );
+   m_AEG.getSettings( *m_pSample->getAEG() );
+   m_EG2.getSettings( *m_pSample->getEG2() );
+   for( size_t i = 0; i < NUM_LFO; i++ )
+   {
+      if( m_pSample->getLFO( i ) )
+      {
+         m_LFOs[i].getSettings( *m_pSample->getLFO( i ) );
+      }
    }
 
    double lAmp;
    double rAmp;
    getLRAmp( lAmp, rAmp );
 
-   for( size_t i = 0; i < nSamples; i++ )
+   // Render in chunks in case the host delivers more samples than announced
+   size_t chunkSize = 0;
+   for( size_t chunkOfs = 0; chunkOfs < nSamples; chunkOfs += chunkSize )
    {
-      if( !handleLoop() )
-         return( false );
+      chunkSize = std::min( scratchSize, nSamples - chunkOfs );
+      if( audioRateCutoff )
+      {
+         // Filter each modulation step separately, so that the filter's
+         // coefficients ramp between the steps' cutoff values
+         chunkSize = std::min( chunkSize, m_SamplesToModStep > 0 ? m_SamplesToModStep : m_ModStepSamples );
+      }
+      bool isPlaying = true;
 
-      if( handleModulations( sampleRate, bpm ) )
+      // Each segment starts with the per-sample decisions of the loop,
+      // modulation and fade out handling, followed by a branch-free kernel
+      size_t nRendered = 0;
+      while( nRendered < chunkSize )
       {
-         if( m_pAEG->hasEnded() && m_pSample->getPlayMode() != Sample::PlayModeShot )
-            return( false );
+         if( !handleLoop() )
+         {
+            isPlaying = false;
+         } else
+         if( m_SamplesToModStep == 0 )
+         {
+            handleModulations( sampleRate, bpm );
+            updateSpeed( sampleRate, audioRatePitch );
+            m_SamplesToModStep = m_ModStepSamples;
+            if( m_AEG.hasEnded() && m_pSample->getPlayMode() != Sample::PlayModeShot )
+               isPlaying = false;
+            else
+               getLRAmp( lAmp, rAmp );
+         }
+
+         if( m_FadeOutGain <= 0.0f )
+            isPlaying = false;
+
+         if( !isPlaying )
+         {
+            // Mix whatever has been rendered of this chunk so far
+            chunkSize = nRendered;
+            break;
+         }
+
+         size_t n = segmentLength( chunkSize - nRendered, fadeOutStep );
+         renderSegment( pPositions + nRendered, pLeftAmp + nRendered, pRightAmp + nRendered, n,
+                        velocity, (float)lAmp, (float)rAmp, fadeOutStep );
+         nRendered += n;
+      }
 
-         getLRAmp( lAmp, rAmp );
+      SampleLoop loop;
+      const SampleLoop *pLoop = getLoop( loop );
+      if( pReadStream )
+      {
+         readStream( pReadStream, pLoop, pPositions, chunkSize, pScratchLeft, pScratchRight, m_Speed < 0.0 );
+      } else
+      {
+         m_pReadBlock( m_pSample->getWave(), pLoop, pPositions, chunkSize, pScratchLeft, pScratchRight );
       }
 
-      uint32_t o = (uint32_t)m_Ofs;
+      for( size_t i = 0; i < chunkSize; i++ )
+      {
+         pScratchLeft[i] *= pLeftAmp[i];
+         pScratchRight[i] *= pRightAmp[i];
+      }
 
-      float lv = m_pSample->getWave()->floatValue( 0, o );
-      float rv = m_pSample->getWave()->floatValue( 1, o );
+      m_Filter.process( pScratchLeft, pScratchRight, (uint32_t)chunkSize, sampleRate );
 
-      pLeft[i] = velocity * lv * (float)lAmp;
-      pRight[i] = velocity * rv * (float)rAmp;
+      float *pLOut = pL + chunkOfs;
+      float *pROut = pR + chunkOfs;
+      for( size_t n = 0; n < chunkSize; n++ )
+      {
+         pLOut[n] += pScratchLeft[n];
+         pROut[n] += pScratchRight[n];
+      }
 
-      m_Ofs += relSpeed;
+      if( !isPlaying )
+         return( false );
    }
 
-   m_pFilter->process( pLeft, pRight, nSamples, sampleRate );
+   return( true );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Read a chunk of a streamed wave. Publishes the read position to the voice's
+disk stream first, so that the I/O thread loads ahead of it.
+\param pReadStream The wave's stream reader
+\param pLoop The voice's loop or nullptr, see getLoop()
+\param pPositions The sample positions
+\param n The number of frames to be read
+\param pLeft Receives the left channel's values
+\param pRight Receives the right channel's values
+\param reverse true if the voice plays backwards
+*/
+/*----------------------------------------------------------------------------*/
+void Voice::readStream( SampleStreamReader pReadStream, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight, bool reverse )
+{
+   if( n == 0 )
+      return;
+
+   const WaveFile *pWave = m_pSample->getWave();
 
-   for( size_t n = 0; n < nSamples; n++ )
+   if( m_pStream && m_pStream->setPosition( pPositions[0], reverse ) )
    {
-      pL[n] += pLeft[n];
-      pR[n] += pRight[n];
+      DiskStreamer::instance().wakeUp();
    }
 
-   return( true );
+   Snapshot<const StreamCache>::Reader cache( pWave->streamCache() );
+   if( !pReadStream( cache.get(), m_pStream, pWave->numSamples(), pLoop, pPositions, n, pLeft, pRight ) )
+   {
+      DiskStreamer::instance().countUnderrun();
+      m_pPart->countUnderrun();
+   }
 }
 
 
@@ -27,7 +27,10 @@
 #ifndef __VOICE_H__
 #define __VOICE_H__
 
-#define MODSTEP_SAMPLES 128
+#define VOICE_DEFAULT_MODRATE ( 44100.0 / 128.0 )
+#define VOICE_MIN_MODRATE 20.0
+#define VOICE_MAX_MODRATE 20000.0
+#define VOICE_STEAL_FADEOUT_SECS 0.005
 
 #include "Sample.h"
 
@@ -36,6 +39,24 @@ namespace SamplerEngine
 {
    class Part;
 
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class ScratchBuffer
+   \date  2026-10-17
+   Preallocated memory a voice renders into before its output is mixed into
+   the output bus. Each buffer holds size elements.
+   */
+   /*----------------------------------------------------------------------------*/
+   struct ScratchBuffer
+   {
+      float *pLeft;
+      float *pRight;
+      float *pLeftAmp;
+      float *pRightAmp;
+      double *pPositions;
+      size_t size;
+   };
+
    /*----------------------------------------------------------------------------*/
    /*!
    \class Voice
@@ -45,31 +66,52 @@ namespace SamplerEngine
    class Voice
    {
    public:
-      Voice( const Part *pPart, const Sample *pSample, int note, int velocity );
+      Voice();
       ~Voice();
 
-      bool process( float *pLeft, float *pRight, size_t nSamples, double sampleRate, double bpm );
+      void start( const Part *pPart, const Sample *pSample, int note, int velocity, uint64_t startIndex );
+      void stop();
+
+      bool process( float *pLeft, float *pRight, size_t nSamples,
+                    const ScratchBuffer &scratch,
+                    double sampleRate, double bpm );
       const Sample *sample() const;
       int midiNote() const;
       void noteOff();
+      bool isNoteOn() const;
+
+      void steal();
+      bool isStolen() const;
+      double getAmplitude() const;
+      uint64_t getStartIndex() const;
 
    protected:
       bool handleLoop();
-      bool handleModulations( double sampleRate, double bpm );
-      double getModValue( ModMatrix::ModSrc modSrc, double defaultValue ) const;
+      void handleModulations( double sampleRate, double bpm );
+      void getModValues( double *pValues, uint32_t usedSources ) const;
 
    private:
       double getPanning() const;
       double getLeftAmp( double pan ) const;
       double getRightAmp( double pan ) const;
       void getLRAmp( double &lAmp, double &rAmp ) const;
+      double getSpeed( double sampleRate ) const;
+      void updateSpeed( double sampleRate, bool audioRate );
+      void updatePitchbend();
+      size_t segmentLength( size_t maxLength, float fadeOutStep ) const;
+      void renderSegment( double *pPositions, float *pLeftAmp, float *pRightAmp, size_t n,
+                          float velocity, float lAmp, float rAmp, float fadeOutStep );
+      const SampleLoop *getLoop( SampleLoop &loop ) const;
+      void readStream( SampleStreamReader pReadStream, const SampleLoop *pLoop, const double *pPositions, size_t n, float *pLeft, float *pRight, bool reverse );
 
       const Part *m_pPart;
       const Sample *m_pSample;
-      ENV *m_pAEG;
-      ENV *m_pEG2;
-      std::vector<LFO *> m_LFOs;
-      Filter *m_pFilter;
+      SampleBlockReader m_pReadBlock;
+      DiskStream *m_pStream;
+      ENV m_AEG;
+      ENV m_EG2;
+      LFO m_LFOs[NUM_LFO];
+      Filter m_Filter;
       bool m_NoteIsOn;
       int m_Note;
       double m_PitchMod;
@@ -77,8 +119,17 @@ namespace SamplerEngine
       double m_AmpMod;
       int m_Velocity;
       double m_Ofs;
-      unsigned long m_nSample;
+      bool m_HasLooped;
+      double m_Speed;
+      double m_SpeedStep;
+      bool m_HasSpeed;
+      double m_Pitchbend;
+      size_t m_ModStepSamples;
+      size_t m_SamplesToModStep;
       double m_RandomBipolar;
+      uint64_t m_StartIndex;
+      bool m_Stolen;
+      float m_FadeOutGain;
    };
 }
 
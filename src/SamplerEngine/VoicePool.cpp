@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file VoicePool.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class implements a pool of preallocated voices.
+*/
+/*----------------------------------------------------------------------------*/
+#include "VoicePool.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+\param capacity The maximum number of voices that can be allocated at once
+*/
+/*----------------------------------------------------------------------------*/
+VoicePool::VoicePool( size_t capacity ) :
+   m_Voices( capacity ),
+   m_NumActive( 0 )
+{
+   m_FreeList.reserve( capacity );
+   for( size_t i = capacity; i > 0; i-- )
+   {
+      m_FreeList.push_back( &m_Voices[i - 1] );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+VoicePool::~VoicePool()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Take a voice from the pool. The voice needs to be started with Voice::start()
+before it can be processed.
+\return Pointer to an unused voice or nullptr if the pool is exhausted
+*/
+/*----------------------------------------------------------------------------*/
+Voice *VoicePool::allocate()
+{
+   if( m_FreeList.empty() )
+      return( nullptr );
+
+   Voice *pVoice = m_FreeList.back();
+   m_FreeList.pop_back();
+   m_NumActive++;
+
+   return( pVoice );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Stop a voice and return it to the pool.
+\param pVoice The voice, which must have been retrieved by allocate()
+*/
+/*----------------------------------------------------------------------------*/
+void VoicePool::release( Voice *pVoice )
+{
+   if( !pVoice )
+      return;
+
+   // Stolen voices have already been uncounted by steal()
+   if( !pVoice->isStolen() && m_NumActive > 0 )
+   {
+      m_NumActive--;
+   }
+
+   pVoice->stop();
+
+   if( m_FreeList.size() < m_FreeList.capacity() )
+   {
+      m_FreeList.push_back( pVoice );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Mark a voice as stolen, so that it fades out and no longer counts as active.
+\param pVoice The voice, which must have been retrieved by allocate()
+*/
+/*----------------------------------------------------------------------------*/
+void VoicePool::steal( Voice *pVoice )
+{
+   if( !pVoice || pVoice->isStolen() )
+      return;
+
+   pVoice->steal();
+   if( m_NumActive > 0 )
+   {
+      m_NumActive--;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The total number of voices within the pool
+*/
+/*----------------------------------------------------------------------------*/
+size_t VoicePool::capacity() const
+{
+   return( m_Voices.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of voices which are currently unused
+*/
+/*----------------------------------------------------------------------------*/
+size_t VoicePool::numFree() const
+{
+   return( m_FreeList.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of allocated voices which haven't been stolen
+*/
+/*----------------------------------------------------------------------------*/
+size_t VoicePool::numActive() const
+{
+   return( m_NumActive );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pVoice A voice retrieved by allocate()
+\return The position of the voice within the pool (0..capacity()-1), which
+can be used to index per-voice data
+*/
+/*----------------------------------------------------------------------------*/
+size_t VoicePool::indexOf( const Voice *pVoice ) const
+{
+   return( (size_t)( pVoice - m_Voices.data() ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param n The position within the pool (0..capacity()-1)
+\return The voice at that position
+*/
+/*----------------------------------------------------------------------------*/
+Voice *VoicePool::voice( size_t n )
+{
+   return( &m_Voices[n] );
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file VoicePool.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class VoicePool.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __VOICEPOOL_H__
+#define __VOICEPOOL_H__
+
+#include <vector>
+
+#include "Voice.h"
+
+#define SAMPLERENGINE_MAXVOICESPERPART 128
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class VoicePool
+   \date  2026-10-17
+   A fixed-capacity pool of preallocated voices. All voices live in one
+   contiguous slab, so that triggering or stopping a voice on the audio
+   thread is a mere free-list operation. The pool also counts the voices
+   which are playing and haven't been stolen, so that the polyphony limits
+   can be checked without walking the voices.
+   */
+   /*----------------------------------------------------------------------------*/
+   class VoicePool
+   {
+   public:
+      VoicePool( size_t capacity = SAMPLERENGINE_MAXVOICESPERPART );
+      ~VoicePool();
+
+      Voice *allocate();
+      void release( Voice *pVoice );
+      void steal( Voice *pVoice );
+
+      size_t capacity() const;
+      size_t numFree() const;
+      size_t numActive() const;
+      size_t indexOf( const Voice *pVoice ) const;
+      Voice *voice( size_t n );
+
+   private:
+      VoicePool( const VoicePool & ) = delete;
+      VoicePool &operator=( const VoicePool & ) = delete;
+
+      std::vector<Voice> m_Voices;
+      std::vector<Voice *> m_FreeList;
+      size_t m_NumActive;
+   };
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include <math.h>
 #include <string.h>
 #include <string>
+#include <new>
 
 #include <DSP/DFT.h>
 
@@ -46,11 +47,20 @@ WaveFile::WaveFile() :
    m_nChannels( (decltype( m_nChannels ))-1 ),
    m_SampleRate( ~(decltype( m_SampleRate ))0 ),
    m_nBits( (decltype( m_nBits ))-1 ),
+   m_SampleFormat( SampleReader::SampleFormatInt16 ),
    m_nSamples( ~(decltype( m_nSamples ))0 ),
    m_LoopStart( ~(decltype( m_LoopStart ))0 ),
    m_LoopEnd( ~(decltype( m_LoopEnd ))0 ),
    m_IsLooped( false ),
-   m_pData( nullptr )
+   m_pValueReader( nullptr ),
+   m_pBlockReaders{},
+   m_pStreamReaders{},
+   m_StreamCache( nullptr ),
+   m_LoadMode( LoadModeRead ),
+   m_pData( nullptr ),
+   m_Storage( StorageRaw ),
+   m_pFloatData( nullptr ),
+   m_FloatStride( 0 )
 {
 }
 
@@ -62,20 +72,19 @@ Destructor
 /*----------------------------------------------------------------------------*/
 WaveFile::~WaveFile()
 {
-   if( m_pData )
-   {
-      delete m_pData;
-   }
+   freeFloatData();
 }
 
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 Create an XML element from the WaveFile.
+\param pState If not nullptr, the sample data is stored in this binary state
+rather than embedded into the XML
 \return Pointer to the new XML element
 */
 /*----------------------------------------------------------------------------*/
-xmlNode *WaveFile::toXml() const
+xmlNode *WaveFile::toXml( BinaryState *pState ) const
 {
    xmlNode *pe = xmlNewNode( nullptr, (xmlChar *)"wave" );
 
@@ -91,6 +100,10 @@ xmlNode *WaveFile::toXml() const
    xmlAddChild( peNBits, xmlNewText( (xmlChar * )stdformat( "{}", m_nBits ).c_str() ) );
    xmlAddChild( pe, peNBits );
 
+   xmlNode *peFormat = xmlNewNode( nullptr, (xmlChar *)"format" );
+   xmlAddChild( peFormat, xmlNewText( (xmlChar * )stdformat( "{}", m_Format ).c_str() ) );
+   xmlAddChild( pe, peFormat );
+
    xmlNode *peNSamples = xmlNewNode( nullptr, (xmlChar *)"nsamples" );
    xmlAddChild( peNSamples, xmlNewText( (xmlChar *)stdformat( "{}", m_nSamples ).c_str() ) );
    xmlAddChild( pe, peNSamples );
@@ -107,13 +120,61 @@ xmlNode *WaveFile::toXml() const
    xmlAddChild( peIsLooped, xmlNewText( (xmlChar *)( m_IsLooped ? "true" : "false" ) ) );
    xmlAddChild( pe, peIsLooped );
 
-   xmlNode *peData = xmlNewNode( nullptr, (xmlChar *)"data" );
-   std::vector<uint8_t> data;
+   xmlNode *peStorage = xmlNewNode( nullptr, (xmlChar *)"storage" );
+   xmlAddChild( peStorage, xmlNewText( (xmlChar *)toString( m_Storage ).c_str() ) );
+   xmlAddChild( pe, peStorage );
+
+   xmlNode *peLoadMode = xmlNewNode( nullptr, (xmlChar *)"loadmode" );
+   xmlAddChild( peLoadMode, xmlNewText( (xmlChar *)toString( m_LoadMode ).c_str() ) );
+   xmlAddChild( pe, peLoadMode );
+
+   if( !m_FileName.empty() )
+   {
+      xmlNode *peFileName = xmlNewNode( nullptr, (xmlChar *)"filename" );
+      xmlAddChild( peFileName, xmlNewText( (xmlChar *)m_FileName.c_str() ) );
+      xmlAddChild( pe, peFileName );
+   }
+
+   // Hashing mapped data would read the whole file, so it is identified by
+   // the file's size and modification time unless the hash is known anyway
+   const MappedFile *pMappedFile = m_pPoolData ? m_pPoolData->file() : nullptr;
+   if( !pMappedFile || m_pPoolData->hasHash() )
+   {
+      xmlNode *peHash = xmlNewNode( nullptr, (xmlChar *)"hash" );
+      xmlAddChild( peHash, xmlNewText( (xmlChar *)stdformat( "{:016x}", contentHash() ).c_str() ) );
+      xmlAddChild( pe, peHash );
+   }
+
+   if( pMappedFile )
+   {
+      xmlNode *peFileSize = xmlNewNode( nullptr, (xmlChar *)"filesize" );
+      xmlAddChild( peFileSize, xmlNewText( (xmlChar *)stdformat( "{}", pMappedFile->size() ).c_str() ) );
+      xmlAddChild( pe, peFileSize );
+
+      xmlNode *peFileTime = xmlNewNode( nullptr, (xmlChar *)"filetime" );
+      xmlAddChild( peFileTime, xmlNewText( (xmlChar *)stdformat( "{}", pMappedFile->modificationTime() ).c_str() ) );
+      xmlAddChild( pe, peFileTime );
+   }
+
+   // With a binary state, the audio data may be referenced by file name and
+   // hash instead of being embedded
    size_t dataSize = (size_t)m_nChannels * (size_t)m_nBits * (size_t)m_nSamples / 8;
-   data.resize( dataSize );
-   memcpy( data.data(), m_pData, dataSize );
-   xmlAddChild( peData, xmlNewText( (xmlChar *)util::base64encode( data ).c_str() ) );
-   xmlAddChild( pe, peData );
+   if( !pState )
+   {
+      xmlNode *peData = xmlNewNode( nullptr, (xmlChar *)"data" );
+      std::vector<uint8_t> data;
+      data.resize( dataSize );
+      memcpy( data.data(), m_pData, dataSize );
+      xmlAddChild( peData, xmlNewText( (xmlChar *)util::base64encode( data ).c_str() ) );
+      xmlAddChild( pe, peData );
+   } else
+   if( pState->getEmbedSamples() || m_FileName.empty() )
+   {
+      xmlNode *peDataChunk = xmlNewNode( nullptr, (xmlChar *)"datachunk" );
+      uint32_t nChunk = pState->addChunk( m_pData, dataSize );
+      xmlAddChild( peDataChunk, xmlNewText( (xmlChar *)stdformat( "{}", nChunk ).c_str() ) );
+      xmlAddChild( pe, peDataChunk );
+   }
 
    return( pe );
 }
@@ -123,10 +184,11 @@ xmlNode *WaveFile::toXml() const
 /*! 2024-06-28
 Reconstruct a Wavefile object from a previously generated XML element (see toXml()).
 \param pe The XML element
+\param pState The binary state the XML has been read from, if any
 \return Pointer to the WaveFile object or nullptr on error
 */
 /*----------------------------------------------------------------------------*/
-WaveFile *WaveFile::fromXml( xmlNode *pe )
+WaveFile *WaveFile::fromXml( xmlNode *pe, const BinaryState *pState )
 {
    if( std::string( (char*)pe->name ) != "wave" )
       return( nullptr );
@@ -134,11 +196,21 @@ WaveFile *WaveFile::fromXml( xmlNode *pe )
    int nChannels = -1;
    int sampleRate = -1;
    int nBits = -1;
+   int format = WAVEFILE_FORMAT_PCM;
    uint32_t nSamples = ~(decltype( nSamples ))0;
    uint32_t loopStart = ~(decltype( loopStart ))0;
    uint32_t loopEnd = ~(decltype( loopEnd ))0;
    bool isLooped = false;
+   Storage storage = StorageRaw;
+   LoadMode loadMode = LoadModeRead;
    uint8_t *pData = nullptr;
+   size_t dataSize = 0;
+   std::string fileName;
+   uint64_t hash = 0;
+   bool haveHash = false;
+   uint64_t fileSize = 0;
+   int64_t fileTime = 0;
+   bool haveFileIdentity = false;
 
    for( xmlNode *pChild = pe->children; pChild; pChild = pChild->next )
    {
@@ -156,6 +228,10 @@ WaveFile *WaveFile::fromXml( xmlNode *pe )
       {
          nBits = std::stoi( std::string( (char*)pChild->children->content ) );
       } else
+      if( tagName == "format" )
+      {
+         format = std::stoi( std::string( (char*)pChild->children->content ) );
+      } else
       if( tagName == "nsamples" )
       {
          nSamples = std::stoul( std::string( (char*)pChild->children->content ) );
@@ -173,22 +249,94 @@ WaveFile *WaveFile::fromXml( xmlNode *pe )
          std::string v = std::string( (char*)pChild->children->content );
          isLooped = ( v == "true" );
       } else
+      if( tagName == "storage" )
+      {
+         storage = storageFromString( std::string( (char*)pChild->children->content ) );
+      } else
+      if( tagName == "loadmode" )
+      {
+         loadMode = loadModeFromString( std::string( (char*)pChild->children->content ) );
+      } else
       if( tagName == "data" )
       {
          std::string v = std::string( (char*)pChild->children->content );
          std::vector<uint8_t> d = util::base64decode( v );
-         size_t dataSize = d.size();
+         dataSize = d.size();
          pData = new uint8_t[dataSize];
          memcpy( pData, d.data(), dataSize );
+      } else
+      if( tagName == "datachunk" && pState && !pData )
+      {
+         uint32_t nChunk = (uint32_t)std::stoul( std::string( (char*)pChild->children->content ) );
+         dataSize = pState->chunkSize( nChunk );
+         pData = new uint8_t[dataSize];
+         if( !pState->readChunk( nChunk, pData, dataSize ) )
+         {
+            delete[] pData;
+            pData = nullptr;
+         }
+      } else
+      if( tagName == "filename" && pChild->children )
+      {
+         fileName = std::string( (char*)pChild->children->content );
+      } else
+      if( tagName == "hash" )
+      {
+         hash = std::stoull( std::string( (char*)pChild->children->content ), nullptr, 16 );
+         haveHash = true;
+      } else
+      if( tagName == "filesize" )
+      {
+         fileSize = std::stoull( std::string( (char*)pChild->children->content ) );
+         haveFileIdentity = true;
+      } else
+      if( tagName == "filetime" )
+      {
+         fileTime = std::stoll( std::string( (char*)pChild->children->content ) );
+      }
+   }
+
+   // The audio data isn't embedded, so it's either in the pool already or it
+   // is loaded from the file, which must not have changed since. Mapped
+   // files are only checked for the format, size and modification time,
+   // since verifying the hash would read the whole file.
+   std::shared_ptr<const WavePool::Data> pPoolData;
+   if( !pData && ( haveHash || haveFileIdentity ) )
+   {
+      if( haveHash )
+      {
+         pPoolData = WavePool::instance().find( hash );
+      }
+
+      if( !pPoolData && !fileName.empty() )
+      {
+         WaveFile *pFile = load( fileName, loadMode );
+         bool sameFormat = pFile &&
+                           pFile->m_nChannels == nChannels && pFile->m_nBits == nBits && pFile->m_Format == format &&
+                           pFile->m_SampleRate == (uint32_t)sampleRate && pFile->m_nSamples == nSamples;
+         if( pFile && pFile->isMapped() )
+         {
+            const MappedFile *pMappedFile = pFile->m_pPoolData->file();
+            if( sameFormat &&
+                ( !haveFileIdentity || ( pMappedFile->size() == fileSize && pMappedFile->modificationTime() == fileTime ) ) )
+            {
+               pPoolData = pFile->m_pPoolData;
+            }
+         } else
+         if( pFile && ( haveHash ? pFile->contentHash() == hash : sameFormat ) )
+         {
+            pPoolData = pFile->m_pPoolData;
+         }
+         delete pFile;
       }
    }
 
    if( nChannels >= 0 && sampleRate >= 0 &&
        nBits >= 0 && nSamples != ~(decltype( nSamples ))0 &&
-       loopStart != ~(decltype( loopStart ))0 && loopEnd != ~(decltype( loopEnd ))0 && pData )
+       loopStart != ~(decltype( loopStart ))0 && loopEnd != ~(decltype( loopEnd ))0 && ( pData || pPoolData ) )
    {
       WaveFile *pWaveFile = new WaveFile();
-      pWaveFile->m_Format = 1;
+      pWaveFile->m_Format = (uint16_t)format;
       pWaveFile->m_nChannels = (uint16_t)nChannels;
       pWaveFile->m_SampleRate = (uint32_t)sampleRate;
       pWaveFile->m_nBits = (uint16_t)nBits;
@@ -196,16 +344,31 @@ WaveFile *WaveFile::fromXml( xmlNode *pe )
       pWaveFile->m_LoopStart = loopStart;
       pWaveFile->m_LoopEnd = loopEnd;
       pWaveFile->m_IsLooped = isLooped;
-      pWaveFile->m_pData = pData;
+      pWaveFile->m_FileName = fileName;
+      pWaveFile->m_LoadMode = loadMode;
+      if( pData )
+      {
+         pWaveFile->setData( pData, dataSize );
+      } else
+      {
+         pWaveFile->setData( pPoolData );
+      }
+
+      if( !pWaveFile->initFormat() || !pWaveFile->initReaders() )
+      {
+         delete pWaveFile;
+         return( nullptr );
+      }
 
-      pWaveFile->m_ToFloatLambdaFunction = pWaveFile->getToFloatLambdaFunction();
+      pWaveFile->updateStreamCache();
+      pWaveFile->setStorage( storage );
 
       return( pWaveFile );
    } else
    {
       if( pData )
       {
-         free( pData );
+         delete[] pData;
       }
       return( nullptr );
    }
@@ -213,68 +376,424 @@ WaveFile *WaveFile::fromXml( xmlNode *pe )
 
 
 /*----------------------------------------------------------------------------*/
-/*! 2024-09-04
-\return A lambda function
-  []( const WaveFile, int nChannel, uint32_t nSample )
-  for reading a float sample value from a WaveFile object.
+/*! 2026-10-17
+Determine the sample format from the WAV format tag and the number of bits.
+\return false if the format isn't supported
+*/
+/*----------------------------------------------------------------------------*/
+bool WaveFile::initFormat()
+{
+   if( m_Format == WAVEFILE_FORMAT_PCM )
+   {
+      if( m_nBits == 8 )
+         m_SampleFormat = SampleReader::SampleFormatInt8;
+      else
+      if( m_nBits == 16 )
+         m_SampleFormat = SampleReader::SampleFormatInt16;
+      else
+      if( m_nBits == 24 )
+         m_SampleFormat = SampleReader::SampleFormatInt24;
+      else
+      if( m_nBits == 32 )
+         m_SampleFormat = SampleReader::SampleFormatInt32;
+      else
+         return( false );
+   } else
+   if( m_Format == WAVEFILE_FORMAT_IEEEFLOAT )
+   {
+      if( m_nBits == 32 )
+         m_SampleFormat = SampleReader::SampleFormatFloat32;
+      else
+      if( m_nBits == 64 )
+         m_SampleFormat = SampleReader::SampleFormatFloat64;
+      else
+         return( false );
+   } else
+   {
+      return( false );
+   }
+
+   return( true );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Select the sample reader functions matching the wave's format.
+\return false if the format isn't supported
 */
 /*----------------------------------------------------------------------------*/
-std::function<float( const WaveFile *, int, uint32_t )> WaveFile::getToFloatLambdaFunction() const
+bool WaveFile::initReaders()
 {
+   bool planar = ( m_Storage == StorageFloatPlanar && m_pFloatData ) || isInPlaceFloat();
+   bool ok = true;
+
+   m_pValueReader = planar ? SampleReader::planarValueReader() :
+                             SampleReader::valueReader( m_SampleFormat, numChannels() );
+   ok = ok && m_pValueReader;
 
-   if( numBits() == 16 )
+   for( SampleReader::Interpolation interpolation : SampleReader::allInterpolations() )
    {
-      if( numChannels() == 1 )
-      {
-         return(
-            []( const WaveFile *pWav, int /*nChan*/, uint32_t nSample ) -> float
-            {
-               uint32_t o = 2 * nSample;
-               uint8_t *pData = pWav->data8();
-               int16_t v = pData[o + 0] | ( pData[o + 1] << 8 );
-               return( (float)v / 32768.0 );
-            }
-         );
-      } else
-      if( numChannels() == 2 )
+      SampleBlockReader pReader = planar ? SampleReader::planarBlockReader( interpolation ) :
+                                           SampleReader::blockReader( m_SampleFormat, numChannels(), interpolation );
+      m_pBlockReaders[interpolation - 1] = pReader;
+      ok = ok && pReader;
+
+      SampleStreamReader pStreamReader = SampleReader::streamReader( m_SampleFormat, numChannels(), interpolation );
+      m_pStreamReaders[interpolation - 1] = pStreamReader;
+      ok = ok && ( pStreamReader || !isStreamed() );
+   }
+
+   // Build the sinc table now rather than on the audio thread
+   SampleReader::sincTable();
+
+   return( ok );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the raw data is mono 32bit float, which the planar float
+readers can use in place without any conversion
+*/
+/*----------------------------------------------------------------------------*/
+bool WaveFile::isInPlaceFloat() const
+{
+   return( m_SampleFormat == SampleReader::SampleFormatFloat32 && m_nChannels == 1 &&
+           m_pData && ( (uintptr_t)m_pData % sizeof( float ) ) == 0 && !isStreamed() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Select how the sample data is kept in memory. StorageRaw keeps only the
+original integer data, which is converted on each read. StorageFloatPlanar
+additionally decodes it into one aligned float buffer per channel, which
+trades memory for faster playback. Streamed waves are never decoded, since
+that would read the whole file, and neither is mono 32bit float data, which
+is used in place.
+The readers and buffers are replaced without any synchronization with the
+audio thread, so the storage mode can only be set while the wave is being
+loaded, before any voice can use it.
+\param storage The storage mode
+*/
+/*----------------------------------------------------------------------------*/
+void WaveFile::setStorage( Storage storage )
+{
+   m_Storage = storage;
+
+   if( m_Storage == StorageFloatPlanar )
+   {
+      if( !m_pFloatData && !isStreamed() && !isInPlaceFloat() )
       {
-         return(
-            []( const WaveFile *pWav, int nChan, uint32_t nSample ) -> float
-            {
-               uint32_t o = ( 4 * nSample ) + ( 2 * (uint32_t)nChan );
-               uint8_t *pData = pWav->data8();
-               int16_t v = pData[o + 0] | ( pData[o + 1] << 8 );
-               return( (float)v / 32768.0 );
-            }
-         );
+         decodeToFloat();
       }
+      initReaders();
    } else
-   if( numBits() == 8 )
    {
-      if( numChannels() == 1 )
-      {
-         return(
-            []( const WaveFile *pWav, int /*nChan*/, uint32_t nSample ) -> float
-            {
-               return( (float)pWav->data8()[nSample] / 128.0 );
-            }
-         );
-      } else
-      if( numChannels() == 2 )
+      // Switch the readers back before releasing the float data
+      initReaders();
+      freeFloatData();
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The storage mode
+*/
+/*----------------------------------------------------------------------------*/
+WaveFile::Storage WaveFile::getStorage() const
+{
+   return( m_Storage );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Decode the raw sample data into planar float buffers.
+*/
+/*----------------------------------------------------------------------------*/
+void WaveFile::decodeToFloat()
+{
+   SampleValueReader pReadRaw = SampleReader::valueReader( m_SampleFormat, numChannels() );
+   if( !pReadRaw || !m_pData || m_nChannels == 0 )
+      return;
+
+   // Round up, so that each channel's buffer starts at an aligned address
+   const size_t align = WAVEFILE_FLOATALIGNMENT / sizeof( float );
+   m_FloatStride = ( ( (size_t)m_nSamples + align - 1 ) / align ) * align;
+
+   m_pFloatData = static_cast<float *>(
+      ::operator new[]( m_FloatStride * m_nChannels * sizeof( float ), std::align_val_t( WAVEFILE_FLOATALIGNMENT ) ) );
+
+   for( int c = 0; c < m_nChannels; c++ )
+   {
+      float *pPlane = m_pFloatData + ( (size_t)c * m_FloatStride );
+      for( uint32_t i = 0; i < m_nSamples; i++ )
       {
-         return(
-            []( const WaveFile *pWav, int nChan, uint32_t nSample ) -> float
-            {
-               uint32_t o = ( 2 * nSample ) + (uint32_t)nChan;
-               uint8_t *pData = pWav->data8();
-               int8_t v = (int8_t)pData[o];
-               return( (float)v / 128.0 );
-            }
-         );
+         pPlane[i] = pReadRaw( this, c, i );
       }
    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Release the planar float buffers.
+*/
+/*----------------------------------------------------------------------------*/
+void WaveFile::freeFloatData()
+{
+   if( m_pFloatData )
+   {
+      ::operator delete[]( m_pFloatData, std::align_val_t( WAVEFILE_FLOATALIGNMENT ) );
+      m_pFloatData = nullptr;
+      m_FloatStride = 0;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nChannel The channel number
+\return Pointer to the channel's float data or nullptr if the wave isn't
+stored as planar float data. For mono waves, all channels map to the same data.
+*/
+/*----------------------------------------------------------------------------*/
+const float *WaveFile::floatData( int nChannel ) const
+{
+   if( !m_pFloatData )
+      return( isInPlaceFloat() ? (const float *)m_pData : nullptr );
+
+   if( nChannel < 0 || nChannel >= m_nChannels )
+      nChannel = 0;
+
+   return( m_pFloatData + ( (size_t)nChannel * m_FloatStride ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param storage A storage mode
+\return A string representation of the storage mode
+*/
+/*----------------------------------------------------------------------------*/
+std::string WaveFile::toString( Storage storage )
+{
+   if( storage == StorageFloatPlanar )
+   {
+      return( "FloatPlanar" );
+   } else
+   {
+      return( "Raw" );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param storage The string representation of a storage mode
+\return The storage mode
+*/
+/*----------------------------------------------------------------------------*/
+WaveFile::Storage WaveFile::storageFromString( const std::string &storage )
+{
+   if( util::trim( util::toLower( storage ) ) == "floatplanar" )
+   {
+      return( StorageFloatPlanar );
+   } else
+   {
+      return( StorageRaw );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return A set of all possible storage modes
+*/
+/*----------------------------------------------------------------------------*/
+std::set<WaveFile::Storage> WaveFile::allStorages()
+{
+   return( std::set<WaveFile::Storage>( { StorageRaw, StorageFloatPlanar } ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return How the audio data is loaded from the file
+*/
+/*----------------------------------------------------------------------------*/
+WaveFile::LoadMode WaveFile::getLoadMode() const
+{
+   return( m_LoadMode );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the audio data is mapped from the file rather than held in
+memory
+*/
+/*----------------------------------------------------------------------------*/
+bool WaveFile::isMapped() const
+{
+   return( m_pPoolData && m_pPoolData->isMapped() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if voices stream the audio data from disk rather than reading
+it from memory
+*/
+/*----------------------------------------------------------------------------*/
+bool WaveFile::isStreamed() const
+{
+   return( m_LoadMode == LoadModeStream && isMapped() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param mode A load mode
+\return A string representation of the load mode
+*/
+/*----------------------------------------------------------------------------*/
+std::string WaveFile::toString( LoadMode mode )
+{
+   if( mode == LoadModeMap )
+   {
+      return( "Map" );
+   } else
+   if( mode == LoadModeStream )
+   {
+      return( "Stream" );
+   } else
+   {
+      return( "Read" );
+   }
+}
 
-   return( nullptr );
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param mode The string representation of a load mode
+\return The load mode
+*/
+/*----------------------------------------------------------------------------*/
+WaveFile::LoadMode WaveFile::loadModeFromString( const std::string &mode )
+{
+   if( util::trim( util::toLower( mode ) ) == "map" )
+   {
+      return( LoadModeMap );
+   } else
+   if( util::trim( util::toLower( mode ) ) == "stream" )
+   {
+      return( LoadModeStream );
+   } else
+   {
+      return( LoadModeRead );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return A set of all possible load modes
+*/
+/*----------------------------------------------------------------------------*/
+std::set<WaveFile::LoadMode> WaveFile::allLoadModes()
+{
+   return( std::set<WaveFile::LoadMode>( { LoadModeRead, LoadModeMap, LoadModeStream } ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation The interpolation kernel
+\return A function for reading blocks of stereo frames from this wave,
+specialized for its bit depth, number of channels and the interpolation
+kernel
+*/
+/*----------------------------------------------------------------------------*/
+SampleBlockReader WaveFile::getBlockReader( SampleReader::Interpolation interpolation ) const
+{
+   if( interpolation < SampleReader::InterpolationNone || interpolation > SAMPLEREADER_NUMINTERPOLATIONS )
+      return( nullptr );
+
+   return( m_pBlockReaders[interpolation - 1] );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param interpolation The interpolation kernel
+\return A function for reading blocks of stereo frames from this wave while
+it is streamed, specialized like getBlockReader()
+*/
+/*----------------------------------------------------------------------------*/
+SampleStreamReader WaveFile::getStreamReader( SampleReader::Interpolation interpolation ) const
+{
+   if( interpolation < SampleReader::InterpolationNone || interpolation > SAMPLEREADER_NUMINTERPOLATIONS )
+      return( nullptr );
+
+   return( m_pStreamReaders[interpolation - 1] );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The resident parts of a streamed wave. The value is nullptr if the
+wave isn't streamed.
+*/
+/*----------------------------------------------------------------------------*/
+const Snapshot<const StreamCache> &WaveFile::streamCache() const
+{
+   return( m_StreamCache );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The audio data in the WavePool
+*/
+/*----------------------------------------------------------------------------*/
+const std::shared_ptr<const WavePool::Data> &WaveFile::poolData() const
+{
+   return( m_pPoolData );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The size of a frame (one sample of all channels) in bytes
+*/
+/*----------------------------------------------------------------------------*/
+size_t WaveFile::frameSize() const
+{
+   return( (size_t)m_nChannels * SampleReader::bytesPerSample( m_SampleFormat ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Copy the head, the tail and the loop of a streamed wave into memory. It is
+rebuilt whenever the loop changes, and voices pick the new one up with their
+next block.
+*/
+/*----------------------------------------------------------------------------*/
+void WaveFile::updateStreamCache()
+{
+   if( !isStreamed() || m_nSamples == 0 )
+      return;
+
+   // Whole blocks, so that streaming starts at a block boundary
+   uint32_t numPreloadFrames = (uint32_t)( ( (uint64_t)m_SampleRate * WAVEFILE_STREAM_PRELOADMS ) / 1000 );
+   numPreloadFrames = ( ( numPreloadFrames + DISKSTREAMER_BLOCKFRAMES - 1 ) / DISKSTREAMER_BLOCKFRAMES ) * DISKSTREAMER_BLOCKFRAMES;
+
+   m_StreamCache.publish( new StreamCache( m_pData, m_nSamples, frameSize(), numPreloadFrames, m_LoopStart, m_LoopEnd ) );
 }
 
 
@@ -289,6 +808,55 @@ uint32_t WaveFile::size() const
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The hash of the audio data, which identifies it in the WavePool and
+in saved states
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t WaveFile::contentHash() const
+{
+   return( m_pPoolData ? m_pPoolData->hash() : 0 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The name of the file the audio data has been loaded from or an empty
+string if unknown
+*/
+/*----------------------------------------------------------------------------*/
+std::string WaveFile::getFileName() const
+{
+   return( m_FileName );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Set the audio data. Identical data which is in use already is shared.
+\param pData The audio data, allocated with new[]. Ownership is taken over.
+\param size The size of the audio data in bytes
+*/
+/*----------------------------------------------------------------------------*/
+void WaveFile::setData( uint8_t *pData, size_t size )
+{
+   setData( WavePool::instance().add( pData, size, m_nChannels, m_nBits, m_SampleRate ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pData The audio data from the WavePool
+*/
+/*----------------------------------------------------------------------------*/
+void WaveFile::setData( std::shared_ptr<const WavePool::Data> pData )
+{
+   m_pPoolData = pData;
+   m_pData = m_pPoolData ? m_pPoolData->data() : nullptr;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 \return Sample number of the loop start
@@ -324,6 +892,8 @@ void WaveFile::setLoopStart( uint32_t v )
    else
    if( m_LoopStart >= m_nSamples )
       m_LoopStart = m_nSamples - 1;
+
+   updateStreamCache();
 }
 
 
@@ -340,6 +910,8 @@ void WaveFile::setLoopEnd( uint32_t v )
    else
    if( m_LoopEnd >= m_nSamples )
       m_LoopEnd = m_nSamples - 1;
+
+   updateStreamCache();
 }
 
 
@@ -387,6 +959,17 @@ int WaveFile::numBits() const
 }
 
 
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The format of the raw sample data
+*/
+/*----------------------------------------------------------------------------*/
+SampleReader::SampleFormat WaveFile::sampleFormat() const
+{
+   return( m_SampleFormat );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
 \return 16bit pointer to the data
@@ -419,7 +1002,7 @@ Retrieve a single sample as a floating point value.
 /*----------------------------------------------------------------------------*/
 float WaveFile::floatValue( int nChannel, uint32_t nSample ) const
 {
-   return( m_ToFloatLambdaFunction( this, nChannel, nSample ) );
+   return( m_pValueReader( this, nChannel, nSample ) );
 }
 
 
@@ -484,12 +1067,20 @@ uint32_t WaveFile::getDWord( const unsigned char *pD )
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
-Load a wave from a file.
+Load a wave from a file. Supported are 8, 16, 24 and 32bit integer as well
+as 32 and 64bit float data with one or two channels, also in the
+WAVE_FORMAT_EXTENSIBLE layout.
 \param fname The file name
+\param mode LoadModeRead reads the audio data into memory. LoadModeMap maps
+the file into memory instead, so loading is almost instant and the OS only
+pages in the parts of the audio data which are played. LoadModeStream maps
+the file, too, but only its head, tail and loop are kept in memory and voices
+stream the rest through the DiskStreamer, so they never wait for the disk.
+\param storage How the sample data is kept in memory, see setStorage()
 \return Pointer to the new WaveFile or nullptr on error
 */
 /*----------------------------------------------------------------------------*/
-WaveFile *WaveFile::load( std::string fname )
+WaveFile *WaveFile::load( std::string fname, LoadMode mode, Storage storage )
 {
    std::ifstream file;
 
@@ -503,6 +1094,7 @@ WaveFile *WaveFile::load( std::string fname )
    if( readTagName( file ) !=  "RIFF" )
    {
       file.close();
+      delete pWav;
       return( nullptr );
    }
 
@@ -511,12 +1103,16 @@ WaveFile *WaveFile::load( std::string fname )
    if( readTagName( file ) != "WAVE" )
    {
       file.close();
+      delete pWav;
       return( nullptr );
    }
 
    bool haveFormat = false;
    bool haveData = false;
    bool ok = true;
+   uint8_t *pData = nullptr;
+   size_t dataSize = 0;
+   size_t dataOffset = 0;
    while( true )
    {
       std::string tagName = readTagName( file );
@@ -538,9 +1134,17 @@ WaveFile *WaveFile::load( std::string fname )
          pWav->m_nChannels = getWord( pFmt + 2 );
          pWav->m_SampleRate = getDWord( pFmt + 4 );
          pWav->m_nBits = getWord( pFmt + 14 );
+
+         // WAVE_FORMAT_EXTENSIBLE: the actual format tag is the first word
+         // of the SubFormat GUID. Samples are stored left-justified in the
+         // container size, so the valid bits can be ignored.
+         if( pWav->m_Format == WAVEFILE_FORMAT_EXTENSIBLE && tagLen >= 40 )
+         {
+            pWav->m_Format = getWord( pFmt + 24 );
+         }
          delete[] pFmt;
 
-         if( pWav->m_Format != 1 )
+         if( !pWav->initFormat() )
          {
             ok = false;
             break;
@@ -570,14 +1174,20 @@ WaveFile *WaveFile::load( std::string fname )
             }
          }
       } else
-      if( tagName == "data" )
+      if( tagName == "data" && !haveData )
       {
-         uint8_t *pData = new uint8_t[tagLen];
-         file.read( (char *)pData, tagLen );
-         pWav->m_pData = pData;
+         dataSize = tagLen;
+         if( mode == LoadModeMap || mode == LoadModeStream )
+         {
+            dataOffset = (size_t)file.tellg();
+         } else
+         {
+            pData = new uint8_t[tagLen];
+            file.read( (char *)pData, tagLen );
+            tagRead = tagLen;
+         }
          haveData = true;
          pWav->m_nSamples = tagLen;
-         tagRead = tagLen;
       }
 
       file.seekg( tagLen - tagRead, std::ios_base::cur );
@@ -588,10 +1198,34 @@ WaveFile *WaveFile::load( std::string fname )
 
    file.close();
 
-   if( !ok )
+   if( !ok || !haveFormat || !haveData )
    {
+      delete[] pData;
       delete pWav;
-      pWav = nullptr;
+      return( nullptr );
+   }
+
+   pWav->m_FileName = fname;
+   pWav->m_LoadMode = mode;
+   if( mode == LoadModeMap || mode == LoadModeStream )
+   {
+      MappedFile *pFile = MappedFile::open( fname );
+      if( !pFile || dataOffset + dataSize > pFile->size() )
+      {
+         delete pFile;
+         delete pWav;
+         return( nullptr );
+      }
+      pWav->setData( WavePool::instance().addMapped( pFile, dataOffset, dataSize, pWav->m_nChannels, pWav->m_nBits, pWav->m_SampleRate ) );
+   } else
+   {
+      pWav->setData( pData, dataSize );
+   }
+
+   if( !pWav->initReaders() )
+   {
+      delete pWav;
+      return( nullptr );
    }
 
    pWav->m_nSamples = pWav->m_nSamples / ( (uint32_t)pWav->m_nChannels * ( (uint32_t)pWav->m_nBits / 8 ) );
@@ -601,7 +1235,14 @@ WaveFile *WaveFile::load( std::string fname )
       pWav->m_LoopEnd = pWav->m_nSamples - 1;
    }
 
-   pWav->m_ToFloatLambdaFunction = pWav->getToFloatLambdaFunction();
+   if( pWav->isStreamed() )
+   {
+      // Start the I/O thread now rather than on the audio thread
+      DiskStreamer::instance();
+      pWav->updateStreamCache();
+   }
+
+   pWav->setStorage( storage );
 
    return( pWav );
 }
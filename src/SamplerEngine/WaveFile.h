@@ -30,12 +30,25 @@
 #include <string>
 #include <iostream>
 #include <fstream>
-#include <functional>
+#include <memory>
+#include <set>
 
 #include <libxml/tree.h>
 
 #include <DSP/Wave.h>
 
+#include "SampleReader.h"
+#include "BinaryState.h"
+#include "DiskStreamer.h"
+#include "Snapshot.h"
+#include "WavePool.h"
+
+#define WAVEFILE_FLOATALIGNMENT 64
+#define WAVEFILE_FORMAT_PCM 0x0001
+#define WAVEFILE_FORMAT_IEEEFLOAT 0x0003
+#define WAVEFILE_FORMAT_EXTENSIBLE 0xFFFE
+#define WAVEFILE_STREAM_PRELOADMS 250
+
 //==============================================================================
 namespace SamplerEngine
 {
@@ -48,9 +61,22 @@ namespace SamplerEngine
    class WaveFile : public DSP::Wave
    {
    public:
+      enum Storage
+      {
+         StorageRaw = 1,
+         StorageFloatPlanar
+      };
+
+      enum LoadMode
+      {
+         LoadModeRead = 1,
+         LoadModeMap,
+         LoadModeStream
+      };
+
       virtual ~WaveFile();
 
-      static WaveFile *load( std::string fname );
+      static WaveFile *load( std::string fname, LoadMode mode = LoadModeRead, Storage storage = StorageRaw );
 
       uint32_t loopStart() const;
       uint32_t loopEnd() const;
@@ -60,21 +86,41 @@ namespace SamplerEngine
 
       uint16_t *data16() const;
       uint8_t *data8() const;
+      const float *floatData( int nChannel ) const;
+
+      Storage getStorage() const;
+      static std::string toString( Storage storage );
+      static Storage storageFromString( const std::string &storage );
+      static std::set<Storage> allStorages();
+
+      LoadMode getLoadMode() const;
+      bool isMapped() const;
+      bool isStreamed() const;
+      static std::string toString( LoadMode mode );
+      static LoadMode loadModeFromString( const std::string &mode );
+      static std::set<LoadMode> allLoadModes();
 
       virtual float floatValue( int nChannel, uint32_t nSample ) const;
       virtual int numChannels() const;
       virtual uint32_t sampleRate() const;
       virtual int numBits() const;
+      SampleReader::SampleFormat sampleFormat() const;
       virtual uint32_t numSamples() const;
 
-      std::function<float( const WaveFile *, int, uint32_t )> getToFloatLambdaFunction() const;
+      SampleBlockReader getBlockReader( SampleReader::Interpolation interpolation ) const;
+      SampleStreamReader getStreamReader( SampleReader::Interpolation interpolation ) const;
+      const Snapshot<const StreamCache> &streamCache() const;
+      const std::shared_ptr<const WavePool::Data> &poolData() const;
+      size_t frameSize() const;
 
       void dft() const;
 
       uint32_t size() const;
+      uint64_t contentHash() const;
+      std::string getFileName() const;
 
-      static WaveFile *fromXml( xmlNode *pe );
-      xmlNode *toXml() const;
+      static WaveFile *fromXml( xmlNode *pe, const BinaryState *pState = nullptr );
+      xmlNode *toXml( BinaryState *pState = nullptr ) const;
 
    protected:
       static std::string readTagName( std::ifstream &file );
@@ -84,19 +130,37 @@ namespace SamplerEngine
 
    private:
       WaveFile();
+      bool initFormat();
+      bool initReaders();
+      bool isInPlaceFloat() const;
+      void setStorage( Storage storage );
+      void decodeToFloat();
+      void freeFloatData();
+      void setData( uint8_t *pData, size_t size );
+      void setData( std::shared_ptr<const WavePool::Data> pData );
+      void updateStreamCache();
 
    private:
-      std::function<float( const WaveFile *, int, uint32_t )> m_ToFloatLambdaFunction;
-
       uint16_t m_Format;
       uint16_t m_nChannels;
       uint32_t m_SampleRate;
       uint16_t m_nBits;
+      SampleReader::SampleFormat m_SampleFormat;
       uint32_t m_nSamples;
       uint32_t m_LoopStart;
       uint32_t m_LoopEnd;
       bool m_IsLooped;
+      SampleValueReader m_pValueReader;
+      SampleBlockReader m_pBlockReaders[SAMPLEREADER_NUMINTERPOLATIONS];
+      SampleStreamReader m_pStreamReaders[SAMPLEREADER_NUMINTERPOLATIONS];
+      Snapshot<const StreamCache> m_StreamCache;
+      std::string m_FileName;
+      LoadMode m_LoadMode;
+      std::shared_ptr<const WavePool::Data> m_pPoolData;
       uint8_t *m_pData;
+      Storage m_Storage;
+      float *m_pFloatData;
+      size_t m_FloatStride;
    };
 }
 
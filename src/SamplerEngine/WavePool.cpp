@@ -0,0 +1,437 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file WavePool.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Shared audio data of WaveFile objects, deduplicated by content
+*/
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "util.h"
+
+#include "WavePool.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+\param pData The audio data, allocated with new[]. Ownership is taken over.
+\param size The size of the audio data in bytes
+\param nChannels The number of channels
+\param nBits The number of bits per sample
+\param sampleRate The sample rate
+\param hash The hash of the audio data (see WavePool::hash())
+*/
+/*----------------------------------------------------------------------------*/
+WavePool::Data::Data( uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate, uint64_t hash ) :
+   m_pData( pData ),
+   m_Size( size ),
+   m_nChannels( nChannels ),
+   m_nBits( nBits ),
+   m_SampleRate( sampleRate ),
+   m_HasHash( true ),
+   m_Hash( hash )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor for audio data in a memory mapped file
+\param pFile The mapped file
+\param offset The offset of the audio data in the file
+\param size The size of the audio data in bytes
+\param nChannels The number of channels
+\param nBits The number of bits per sample
+\param sampleRate The sample rate
+*/
+/*----------------------------------------------------------------------------*/
+WavePool::Data::Data( std::shared_ptr<const MappedFile> pFile, size_t offset, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate ) :
+   m_pFile( pFile ),
+   m_pData( (uint8_t *)pFile->data() + offset ),
+   m_Size( size ),
+   m_nChannels( nChannels ),
+   m_nBits( nBits ),
+   m_SampleRate( sampleRate ),
+   m_HasHash( false ),
+   m_Hash( 0 )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+WavePool::Data::~Data()
+{
+   if( !m_pFile )
+   {
+      delete[] m_pData;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The audio data. It must not be modified.
+*/
+/*----------------------------------------------------------------------------*/
+uint8_t *WavePool::Data::data() const
+{
+   return( m_pData );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The size of the audio data in bytes
+*/
+/*----------------------------------------------------------------------------*/
+size_t WavePool::Data::size() const
+{
+   return( m_Size );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The hash of the audio data (see WavePool::hash()). For mapped data,
+the first call reads the whole data.
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t WavePool::Data::hash() const
+{
+   if( !m_HasHash.load( std::memory_order_acquire ) )
+   {
+      std::lock_guard<std::mutex> lock( m_HashMutex );
+      if( !m_HasHash.load( std::memory_order_relaxed ) )
+      {
+         m_Hash = WavePool::hash( m_pData, m_Size, m_nChannels, m_nBits, m_SampleRate );
+         m_HasHash.store( true, std::memory_order_release );
+      }
+   }
+
+   return( m_Hash );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the hash has been computed already
+*/
+/*----------------------------------------------------------------------------*/
+bool WavePool::Data::hasHash() const
+{
+   return( m_HasHash.load( std::memory_order_acquire ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return true if the audio data is in a memory mapped file
+*/
+/*----------------------------------------------------------------------------*/
+bool WavePool::Data::isMapped() const
+{
+   return( m_pFile != nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The mapped file the audio data is in or nullptr if the data is in
+memory
+*/
+/*----------------------------------------------------------------------------*/
+const MappedFile *WavePool::Data::file() const
+{
+   return( m_pFile.get() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param pData Audio data
+\param size The size of the audio data in bytes
+\param nChannels The number of channels
+\param nBits The number of bits per sample
+\param sampleRate The sample rate
+\return true if the audio data and its format are identical to this one
+*/
+/*----------------------------------------------------------------------------*/
+bool WavePool::Data::isEqual( const uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate ) const
+{
+   return( size == m_Size &&
+           nChannels == m_nChannels &&
+           nBits == m_nBits &&
+           sampleRate == m_SampleRate &&
+           memcmp( pData, m_pData, size ) == 0 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+WavePool::WavePool()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The process-wide pool
+*/
+/*----------------------------------------------------------------------------*/
+WavePool &WavePool::instance()
+{
+   static WavePool pool;
+
+   return( pool );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add audio data to the pool. If identical data is in the pool already, the
+new data is freed and the existing data is returned instead.
+\param pData The audio data, allocated with new[]. Ownership is taken over.
+\param size The size of the audio data in bytes
+\param nChannels The number of channels
+\param nBits The number of bits per sample
+\param sampleRate The sample rate
+\return The pooled data
+*/
+/*----------------------------------------------------------------------------*/
+std::shared_ptr<const WavePool::Data> WavePool::add( uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate )
+{
+   uint64_t h = hash( pData, size, nChannels, nBits, sampleRate );
+
+   std::lock_guard<std::mutex> lock( m_Mutex );
+
+   auto range = m_Data.equal_range( h );
+   for( auto i = range.first; i != range.second; i++ )
+   {
+      std::shared_ptr<const Data> pExisting = i->second.lock();
+      if( pExisting && pExisting->isEqual( pData, size, nChannels, nBits, sampleRate ) )
+      {
+         delete[] pData;
+         return( pExisting );
+      }
+   }
+
+   removeExpired();
+
+   std::shared_ptr<const Data> pNew = std::make_shared<const Data>( pData, size, nChannels, nBits, sampleRate, h );
+   m_Data.insert( { h, pNew } );
+
+   return( pNew );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Add audio data in a memory mapped file to the pool. Mapped data is shared
+by file (path, size and modification time) rather than by content, so that
+nothing has to be read from the file.
+\param pFile The mapped file. Ownership is taken over.
+\param offset The offset of the audio data in the file
+\param size The size of the audio data in bytes
+\param nChannels The number of channels
+\param nBits The number of bits per sample
+\param sampleRate The sample rate
+\return The pooled data
+*/
+/*----------------------------------------------------------------------------*/
+std::shared_ptr<const WavePool::Data> WavePool::addMapped( MappedFile *pFile, size_t offset, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate )
+{
+   std::shared_ptr<const MappedFile> pMappedFile( pFile );
+   std::string key = stdformat( "{}|{}|{}|{}|{}|{}", pFile->identity(), offset, size, nChannels, nBits, sampleRate );
+
+   std::lock_guard<std::mutex> lock( m_Mutex );
+
+   auto i = m_MappedData.find( key );
+   if( i != m_MappedData.end() )
+   {
+      std::shared_ptr<const Data> pExisting = i->second.lock();
+      if( pExisting )
+      {
+         return( pExisting );
+      }
+   }
+
+   removeExpired();
+
+   std::shared_ptr<const Data> pNew = std::make_shared<const Data>( pMappedFile, offset, size, nChannels, nBits, sampleRate );
+   m_MappedData[key] = pNew;
+
+   return( pNew );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Mapped data is only found if its hash has been computed already.
+\param hash The hash of the audio data (see WavePool::hash())
+\return The pooled data or nullptr if there is no data with that hash
+*/
+/*----------------------------------------------------------------------------*/
+std::shared_ptr<const WavePool::Data> WavePool::find( uint64_t hash ) const
+{
+   std::lock_guard<std::mutex> lock( m_Mutex );
+
+   auto range = m_Data.equal_range( hash );
+   for( auto i = range.first; i != range.second; i++ )
+   {
+      std::shared_ptr<const Data> pExisting = i->second.lock();
+      if( pExisting )
+      {
+         return( pExisting );
+      }
+   }
+
+   for( const auto &entry : m_MappedData )
+   {
+      std::shared_ptr<const Data> pExisting = entry.second.lock();
+      if( pExisting && pExisting->hasHash() && pExisting->hash() == hash )
+      {
+         return( pExisting );
+      }
+   }
+
+   return( nullptr );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of distinct audio data in use
+*/
+/*----------------------------------------------------------------------------*/
+size_t WavePool::size() const
+{
+   std::lock_guard<std::mutex> lock( m_Mutex );
+
+   size_t n = 0;
+   for( const auto &entry : m_Data )
+   {
+      if( !entry.second.expired() )
+      {
+         n++;
+      }
+   }
+   for( const auto &entry : m_MappedData )
+   {
+      if( !entry.second.expired() )
+      {
+         n++;
+      }
+   }
+
+   return( n );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Remove the entries of data which has been freed. m_Mutex must be locked.
+*/
+/*----------------------------------------------------------------------------*/
+void WavePool::removeExpired()
+{
+   for( auto i = m_Data.begin(); i != m_Data.end(); )
+   {
+      if( i->second.expired() )
+      {
+         i = m_Data.erase( i );
+      } else
+      {
+         i++;
+      }
+   }
+
+   for( auto i = m_MappedData.begin(); i != m_MappedData.end(); )
+   {
+      if( i->second.expired() )
+      {
+         i = m_MappedData.erase( i );
+      } else
+      {
+         i++;
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+A 64bit hash of audio data and its format. It identifies audio data in
+saved states, so it must never change.
+\param pData Audio data
+\param size The size of the audio data in bytes
+\param nChannels The number of channels
+\param nBits The number of bits per sample
+\param sampleRate The sample rate
+\return The hash
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t WavePool::hash( const uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate )
+{
+   const uint64_t m1 = 0x87c37b91114253d5ULL;
+   const uint64_t m2 = 0x4cf5ad432745937fULL;
+
+   uint64_t h = ( (uint64_t)sampleRate << 32 ) ^ ( (uint64_t)nBits << 16 ) ^ nChannels;
+   h ^= (uint64_t)size * 0x9e3779b97f4a7c15ULL;
+
+   size_t i = 0;
+   for( ; i + 8 <= size; i += 8 )
+   {
+      uint64_t w;
+      memcpy( &w, pData + i, 8 );
+      w *= m1;
+      w = ( w << 31 ) | ( w >> 33 );
+      w *= m2;
+      h ^= w;
+      h = ( ( h << 27 ) | ( h >> 37 ) ) * 5 + 0x52dce729;
+   }
+
+   uint64_t tail = 0;
+   for( size_t j = 0; i + j < size; j++ )
+   {
+      tail |= (uint64_t)pData[i + j] << ( j * 8 );
+   }
+   h ^= tail * m1;
+
+   // Final avalanche (from MurmurHash3)
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+
+   return( h );
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file WavePool.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class WavePool.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __WAVEPOOL_H__
+#define __WAVEPOOL_H__
+
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "MappedFile.h"
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class WavePool
+   \date  2026-10-17
+   The audio data of all WaveFile objects in the process, keyed by a hash of
+   the content. WaveFile objects with the same audio data (e.g. the same WAV
+   file in several zones, layers, parts or plugin instances) share it, while
+   the per-zone settings like the loop points stay with each WaveFile.
+   The data is freed when the last WaveFile referencing it is deleted.
+   Data is either owned memory or a region of a memory mapped file, which the
+   OS pages in on demand.
+   */
+   /*----------------------------------------------------------------------------*/
+   class WavePool
+   {
+   public:
+      /*----------------------------------------------------------------------------*/
+      /*!
+      \class Data
+      \date  2026-10-17
+      Audio data in the pool. Immutable once it has been added. The hash of
+      mapped data is computed on first use, since that reads the whole file.
+      */
+      /*----------------------------------------------------------------------------*/
+      class Data
+      {
+      public:
+         Data( uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate, uint64_t hash );
+         Data( std::shared_ptr<const MappedFile> pFile, size_t offset, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate );
+         ~Data();
+
+         uint8_t *data() const;
+         size_t size() const;
+         uint64_t hash() const;
+         bool hasHash() const;
+         bool isMapped() const;
+         const MappedFile *file() const;
+         bool isEqual( const uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate ) const;
+
+      private:
+         Data( const Data & ) = delete;
+         Data &operator=( const Data & ) = delete;
+
+         std::shared_ptr<const MappedFile> m_pFile;
+         uint8_t *m_pData;
+         size_t m_Size;
+         uint16_t m_nChannels;
+         uint16_t m_nBits;
+         uint32_t m_SampleRate;
+         mutable std::mutex m_HashMutex;
+         mutable std::atomic<bool> m_HasHash;
+         mutable uint64_t m_Hash;
+      };
+
+      static WavePool &instance();
+
+      std::shared_ptr<const Data> add( uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate );
+      std::shared_ptr<const Data> addMapped( MappedFile *pFile, size_t offset, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate );
+      std::shared_ptr<const Data> find( uint64_t hash ) const;
+      size_t size() const;
+
+      static uint64_t hash( const uint8_t *pData, size_t size, uint16_t nChannels, uint16_t nBits, uint32_t sampleRate );
+
+   private:
+      WavePool();
+      WavePool( const WavePool & ) = delete;
+      WavePool &operator=( const WavePool & ) = delete;
+
+      void removeExpired();
+
+   private:
+      mutable std::mutex m_Mutex;
+      std::multimap<uint64_t, std::weak_ptr<const Data>> m_Data;
+      std::map<std::string, std::weak_ptr<const Data>> m_MappedData;
+   };
+}
+
+#endif
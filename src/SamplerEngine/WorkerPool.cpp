@@ -0,0 +1,258 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file WorkerPool.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class implements a pool of realtime worker threads.
+*/
+/*----------------------------------------------------------------------------*/
+#if defined( _WIN32 )
+#include <windows.h>
+#elif defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#include <emmintrin.h>
+#endif
+
+#include "WorkerPool.h"
+
+using namespace SamplerEngine;
+
+// m_State holds the generation of the current run() in the upper and the
+// number of unclaimed jobs in the lower 32 bits. Jobs can only be claimed
+// for the generation they belong to, so a worker waking up late can never
+// take a job of the next run().
+#define WORKERPOOL_STATE( generation, numJobs ) ( ( (uint64_t)( generation ) << 32 ) | (uint64_t)( numJobs ) )
+#define WORKERPOOL_GENERATION( state ) ( (uint32_t)( ( state ) >> 32 ) )
+#define WORKERPOOL_UNCLAIMED( state ) ( (uint32_t)( ( state ) & 0xffffffff ) )
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+\param numThreads The total number of threads, including the one calling
+run(). numThreads - 1 worker threads are started.
+*/
+/*----------------------------------------------------------------------------*/
+WorkerPool::WorkerPool( size_t numThreads ) :
+   m_State( WORKERPOOL_STATE( 0, 0 ) ),
+   m_NumPending( 0 ),
+   m_Quit( false ),
+   m_Generation( 0 ),
+   m_Job( nullptr ),
+   m_pContext( nullptr ),
+   m_NumJobs( 0 )
+{
+   if( numThreads < 1 )
+      numThreads = 1;
+   else
+   if( numThreads > WORKERPOOL_MAXTHREADS )
+      numThreads = WORKERPOOL_MAXTHREADS;
+
+   m_Threads.reserve( numThreads - 1 );
+   for( size_t i = 1; i < numThreads; i++ )
+   {
+      m_Threads.emplace_back( &WorkerPool::workerMain, this, i );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+WorkerPool::~WorkerPool()
+{
+   m_Quit.store( true );
+   m_State.fetch_add( WORKERPOOL_STATE( 1, 0 ) );
+   m_State.notify_all();
+
+   for( std::thread &t : m_Threads )
+   {
+      t.join();
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The total number of threads, including the one calling run()
+*/
+/*----------------------------------------------------------------------------*/
+size_t WorkerPool::numThreads() const
+{
+   return( m_Threads.size() + 1 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Execute numJobs jobs on all threads and return when all of them are done.
+Must only be called from one thread at a time.
+\param job The function to be called for each job
+\param pContext Passed to each job
+\param numJobs The number of jobs
+*/
+/*----------------------------------------------------------------------------*/
+void WorkerPool::run( Job job, void *pContext, size_t numJobs )
+{
+   if( numJobs == 0 )
+      return;
+
+   if( std::this_thread::get_id() != m_CallerId )
+   {
+      adoptCallerPriority();
+   }
+
+   // No worker can access these while there are no claimable jobs
+   m_Job = job;
+   m_pContext = pContext;
+   m_NumJobs = numJobs;
+   m_Generation++;
+
+   m_NumPending.store( numJobs, std::memory_order_relaxed );
+   m_State.store( WORKERPOOL_STATE( m_Generation, numJobs ), std::memory_order_release );
+   m_State.notify_all();
+
+   work( 0, m_Generation );
+
+   while( m_NumPending.load( std::memory_order_acquire ) > 0 )
+   {
+      pause();
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Claim and execute jobs of a generation until there are none left.
+\param nThread The number of the executing thread
+\param generation The generation of the jobs
+*/
+/*----------------------------------------------------------------------------*/
+void WorkerPool::work( size_t nThread, uint32_t generation )
+{
+   uint64_t state = m_State.load( std::memory_order_acquire );
+
+   while( WORKERPOOL_GENERATION( state ) == generation && WORKERPOOL_UNCLAIMED( state ) > 0 )
+   {
+      if( m_State.compare_exchange_weak( state, state - 1, std::memory_order_acq_rel ) )
+      {
+         size_t nJob = m_NumJobs - WORKERPOOL_UNCLAIMED( state );
+         m_Job( m_pContext, nJob, nThread );
+         m_NumPending.fetch_sub( 1, std::memory_order_release );
+         state = m_State.load( std::memory_order_acquire );
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+The worker threads' main loop
+\param nThread The number of the worker thread (1..numThreads() - 1)
+*/
+/*----------------------------------------------------------------------------*/
+void WorkerPool::workerMain( size_t nThread )
+{
+   uint32_t generation = 0;
+
+   for( ;; )
+   {
+      uint64_t state = m_State.load( std::memory_order_acquire );
+
+      for( int i = 0; i < WORKERPOOL_SPINCOUNT && WORKERPOOL_GENERATION( state ) == generation; i++ )
+      {
+         pause();
+         state = m_State.load( std::memory_order_acquire );
+      }
+
+      while( WORKERPOOL_GENERATION( state ) == generation )
+      {
+         m_State.wait( state, std::memory_order_acquire );
+         state = m_State.load( std::memory_order_acquire );
+      }
+
+      if( m_Quit.load() )
+         return;
+
+      generation = WORKERPOOL_GENERATION( state );
+      work( nThread, generation );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Give the worker threads the scheduling of the thread calling run(), which is
+normally the host's audio thread. A worker must not preempt the thread which
+waits for it, so it never gets a higher priority, and the threads are not
+pinned to any cores, which might be the host's audio cores. Only done when
+the calling thread changes. Failures are ignored, the workers then simply
+keep their current scheduling.
+*/
+/*----------------------------------------------------------------------------*/
+void WorkerPool::adoptCallerPriority()
+{
+   m_CallerId = std::this_thread::get_id();
+
+#if defined( _WIN32 )
+   int priority = GetThreadPriority( GetCurrentThread() );
+   if( priority == THREAD_PRIORITY_ERROR_RETURN )
+      return;
+
+   for( std::thread &t : m_Threads )
+   {
+      SetThreadPriority( (HANDLE)t.native_handle(), priority );
+   }
+#elif defined( __linux__ )
+   int policy;
+   sched_param param;
+   if( pthread_getschedparam( pthread_self(), &policy, &param ) != 0 )
+      return;
+
+   for( std::thread &t : m_Threads )
+   {
+      pthread_setschedparam( t.native_handle(), policy, &param );
+   }
+#endif
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Hint the CPU that the calling thread is spinning.
+*/
+/*----------------------------------------------------------------------------*/
+void WorkerPool::pause()
+{
+#if defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+   _mm_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+   __asm__ __volatile__( "yield" );
+#else
+   std::this_thread::yield();
+#endif
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file WorkerPool.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class WorkerPool.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __WORKERPOOL_H__
+#define __WORKERPOOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define WORKERPOOL_SPINCOUNT 4096
+#define WORKERPOOL_MAXTHREADS 16
+
+//==============================================================================
+namespace SamplerEngine
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class WorkerPool
+   \date  2026-10-17
+   A fixed set of worker threads for distributing realtime work. The thread
+   calling run() takes part in the work as thread 0 and the workers run at
+   its priority. Jobs are claimed lock-free, idle workers spin for a short
+   while before they go to sleep, and run() neither allocates memory nor
+   takes any locks.
+   */
+   /*----------------------------------------------------------------------------*/
+   class WorkerPool
+   {
+   public:
+      typedef void ( *Job )( void *pContext, size_t nJob, size_t nThread );
+
+      WorkerPool( size_t numThreads );
+      ~WorkerPool();
+
+      size_t numThreads() const;
+      void run( Job job, void *pContext, size_t numJobs );
+
+   private:
+      WorkerPool( const WorkerPool & ) = delete;
+      WorkerPool &operator=( const WorkerPool & ) = delete;
+
+      void workerMain( size_t nThread );
+      void work( size_t nThread, uint32_t generation );
+      void adoptCallerPriority();
+      static void pause();
+
+   private:
+      std::vector<std::thread> m_Threads;
+      std::thread::id m_CallerId;
+      std::atomic<uint64_t> m_State;
+      std::atomic<size_t> m_NumPending;
+      std::atomic<bool> m_Quit;
+      uint32_t m_Generation;
+      Job m_Job;
+      void *m_pContext;
+      size_t m_NumJobs;
+   };
+}
+
+#endif
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file ZoneTable.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class implements a note/velocity index of a part's samples.
+*/
+/*----------------------------------------------------------------------------*/
+#include <algorithm>
+
+#include "ZoneTable.h"
+#include "Sample.h"
+
+using namespace SamplerEngine;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor. Builds the table, which takes O(notes * zones) plus the time to
+fill the cells of the distinct zone sets. Must not be called from the audio
+thread.
+\param samples The samples of the part
+*/
+/*----------------------------------------------------------------------------*/
+ZoneTable::ZoneTable( const std::list<Sample *> &samples )
+{
+   std::vector<Sample *> noteZones;
+   std::vector<Sample *> prevNoteZones;
+   std::vector<Sample *> cellZones;
+
+   for( int note = 0; note < ZONETABLE_NUMNOTES; note++ )
+   {
+      noteZones.clear();
+      for( Sample *pSample : samples )
+      {
+         if( pSample->matchesMidiNote( note ) )
+         {
+            noteZones.push_back( pSample );
+         }
+      }
+
+      if( note > 0 && noteZones == prevNoteZones )
+      {
+         // Zones usually span several notes, so whole columns repeat
+         for( int vel = 0; vel < ZONETABLE_NUMVELOCITIES; vel++ )
+         {
+            m_Begin[cellIndex( note, vel )] = m_Begin[cellIndex( note - 1, vel )];
+            m_End[cellIndex( note, vel )] = m_End[cellIndex( note - 1, vel )];
+         }
+      } else
+      {
+         // The zones can only change at the velocity range limits
+         bool velChanges[ZONETABLE_NUMVELOCITIES] = { true };
+         for( Sample *pSample : noteZones )
+         {
+            int minVel = pSample->getMinVelocity();
+            int maxVel = pSample->getMaxVelocity();
+            if( minVel > 0 && minVel < ZONETABLE_NUMVELOCITIES )
+            {
+               velChanges[minVel] = true;
+            }
+            if( maxVel >= 0 && maxVel < ZONETABLE_NUMVELOCITIES - 1 )
+            {
+               velChanges[maxVel + 1] = true;
+            }
+         }
+
+         for( int vel = 0; vel < ZONETABLE_NUMVELOCITIES; vel++ )
+         {
+            size_t nCell = cellIndex( note, vel );
+            if( !velChanges[vel] )
+            {
+               m_Begin[nCell] = m_Begin[nCell - 1];
+               m_End[nCell] = m_End[nCell - 1];
+               continue;
+            }
+
+            cellZones.clear();
+            for( Sample *pSample : noteZones )
+            {
+               if( pSample->matchesVelocity( vel ) )
+               {
+                  cellZones.push_back( pSample );
+               }
+            }
+
+            if( vel > 0 && cellEquals( cellIndex( note, vel - 1 ), cellZones ) )
+            {
+               m_Begin[nCell] = m_Begin[cellIndex( note, vel - 1 )];
+               m_End[nCell] = m_End[cellIndex( note, vel - 1 )];
+            } else
+            if( note > 0 && cellEquals( cellIndex( note - 1, vel ), cellZones ) )
+            {
+               m_Begin[nCell] = m_Begin[cellIndex( note - 1, vel )];
+               m_End[nCell] = m_End[cellIndex( note - 1, vel )];
+            } else
+            {
+               m_Begin[nCell] = (uint32_t)m_Zones.size();
+               m_Zones.insert( m_Zones.end(), cellZones.begin(), cellZones.end() );
+               m_End[nCell] = (uint32_t)m_Zones.size();
+            }
+         }
+      }
+
+      std::swap( noteZones, prevNoteZones );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+ZoneTable::~ZoneTable()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param note The MIDI note number
+\param vel The MIDI velocity
+\return The number of zones matching the note and velocity, 0 if either is
+out of range
+*/
+/*----------------------------------------------------------------------------*/
+size_t ZoneTable::numZones( int note, int vel ) const
+{
+   if( note < 0 || note >= ZONETABLE_NUMNOTES || vel < 0 || vel >= ZONETABLE_NUMVELOCITIES )
+      return( 0 );
+
+   size_t nCell = cellIndex( note, vel );
+   return( m_End[nCell] - m_Begin[nCell] );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param note The MIDI note number
+\param vel The MIDI velocity
+\return The zones matching the note and velocity, see numZones(). nullptr if
+either is out of range.
+*/
+/*----------------------------------------------------------------------------*/
+Sample *const *ZoneTable::zones( int note, int vel ) const
+{
+   if( note < 0 || note >= ZONETABLE_NUMNOTES || vel < 0 || vel >= ZONETABLE_NUMVELOCITIES )
+      return( nullptr );
+
+   return( m_Zones.data() + m_Begin[cellIndex( note, vel )] );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The total number of zone references stored for all cells
+*/
+/*----------------------------------------------------------------------------*/
+size_t ZoneTable::numEntries() const
+{
+   return( m_Zones.size() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param note The MIDI note number (0..ZONETABLE_NUMNOTES-1)
+\param vel The MIDI velocity (0..ZONETABLE_NUMVELOCITIES-1)
+\return The index of the cell
+*/
+/*----------------------------------------------------------------------------*/
+size_t ZoneTable::cellIndex( int note, int vel )
+{
+   return( (size_t)note * ZONETABLE_NUMVELOCITIES + (size_t)vel );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param nCell The index of a cell which has already been filled
+\param zones A list of zones
+\return true if the cell refers to exactly the given zones
+*/
+/*----------------------------------------------------------------------------*/
+bool ZoneTable::cellEquals( size_t nCell, const std::vector<Sample *> &zones ) const
+{
+   if( m_End[nCell] - m_Begin[nCell] != zones.size() )
+      return( false );
+
+   return( std::equal( zones.begin(), zones.end(), m_Zones.begin() + m_Begin[nCell] ) );
+}
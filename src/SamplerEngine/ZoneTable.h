@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file ZoneTable.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class ZoneTable.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __ZONETABLE_H__
+#define __ZONETABLE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <vector>
+
+#define ZONETABLE_NUMNOTES 128
+#define ZONETABLE_NUMVELOCITIES 128
+
+//==============================================================================
+namespace SamplerEngine
+{
+   class Sample;
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class ZoneTable
+   \date  2026-10-17
+   Index of the samples (zones) of a part by MIDI note and velocity. Each of
+   the 128x128 cells refers to a span of the zones matching it, in the order
+   of the part's sample list. Neighbouring cells with the same zones share
+   their span. The table is immutable once built, so it can be published to
+   the audio thread, which looks up a note-on without walking all zones or
+   allocating memory.
+   */
+   /*----------------------------------------------------------------------------*/
+   class ZoneTable
+   {
+   public:
+      ZoneTable( const std::list<Sample *> &samples );
+      ~ZoneTable();
+
+      size_t numZones( int note, int vel ) const;
+      Sample *const *zones( int note, int vel ) const;
+      size_t numEntries() const;
+
+   private:
+      ZoneTable( const ZoneTable & ) = delete;
+      ZoneTable &operator=( const ZoneTable & ) = delete;
+
+      static size_t cellIndex( int note, int vel );
+      bool cellEquals( size_t nCell, const std::vector<Sample *> &zones ) const;
+
+      std::vector<Sample *> m_Zones;
+      uint32_t m_Begin[ZONETABLE_NUMNOTES * ZONETABLE_NUMVELOCITIES];
+      uint32_t m_End[ZONETABLE_NUMNOTES * ZONETABLE_NUMVELOCITIES];
+   };
+}
+
+#endif
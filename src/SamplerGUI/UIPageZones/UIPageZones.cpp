@@ -117,6 +117,14 @@ UIPageZones::UIPageZones( PluginEditor *pEditor ) :
       ( editorSectionHeight / 3 ) - ( margin * 2 ) );
    addAndMakeVisible( m_pUISectionFilter );
 
+   m_pUISectionPart = new SamplerGUI::UISectionPart( this );
+   m_pUISectionPart->setBounds(
+      xStart + ( ( 2 * editorSectionWidth ) / 4 ) + margin,
+      yStart + margin,
+      ( editorSectionWidth / 4 ) - ( margin * 2 ),
+      ( editorSectionHeight / 3 ) - ( margin * 2 ) );
+   addAndMakeVisible( m_pUISectionPart );
+
    m_pUISectionOutput = new SamplerGUI::UISectionOutput( this );
    m_pUISectionOutput->setBounds(
       xStart + ( ( 3 * editorSectionWidth ) / 4 ) + margin,
@@ -142,6 +150,14 @@ UIPageZones::UIPageZones( PluginEditor *pEditor ) :
       ( editorSectionHeight / 3 ) - ( margin * 2 ) );
    addAndMakeVisible( m_pUISectionLFO );
 
+   m_pUISectionEngine = new SamplerGUI::UISectionEngine( this );
+   m_pUISectionEngine->setBounds(
+      xStart + ( ( 3 * editorSectionWidth ) / 4 ) + margin,
+      yStart + ( editorSectionHeight / 3 ) + margin,
+      ( editorSectionWidth / 4 ) - ( margin * 2 ),
+      ( editorSectionHeight / 3 ) - ( margin * 2 ) );
+   addAndMakeVisible( m_pUISectionEngine );
+
    // Third row
    m_pUISectionAEG = new SamplerGUI::UISectionAEG( this );
    m_pUISectionAEG->setBounds(
@@ -190,6 +206,8 @@ UIPageZones::~UIPageZones()
    delete m_pUISectionFilter;
    delete m_pUISectionOutput;
    delete m_pUISectionModMatrix;
+   delete m_pUISectionEngine;
+   delete m_pUISectionPart;
 
    for( size_t i = 0; i < m_LayerButtons.size(); i++ )
    {
@@ -231,7 +249,7 @@ void UIPageZones::buttonClicked( Button *pButton )
    } else
    if( pButton == m_pbSolo )
    {
-      //bool bSolo = m_pbSolo->getToggleState();
+      editor()->processor().publishSelection();
    } else
    if( nLayerButton >= 0 )
    {
@@ -292,11 +310,15 @@ void UIPageZones::buttonStateChanged( Button */*pButton*/ )
 
 /*----------------------------------------------------------------------------*/
 /*! 2024-06-28
+Called when another part has been selected or the parts have been replaced,
+e.g. by importing a program or a multi
 */
 /*----------------------------------------------------------------------------*/
 void UIPageZones::currentPartChanged( size_t /*nPart*/ )
 {
 //   m_pUISectionKeyboard->clearSelectedSamples();
+   m_pUISectionPart->partUpdated();
+   m_pUISectionEngine->engineUpdated();
 }
 
 
@@ -38,6 +38,8 @@
 #include "UISectionFilter.h"
 #include "UISectionOutput.h"
 #include "UISectionModMatrix.h"
+#include "UISectionEngine.h"
+#include "UISectionPart.h"
 #include "UISectionSamplerKeyboard.h"
 
 class PluginEditor;
@@ -79,6 +81,8 @@ namespace SamplerGUI
       SamplerGUI::UISectionFilter *m_pUISectionFilter;
       SamplerGUI::UISectionOutput *m_pUISectionOutput;
       SamplerGUI::UISectionModMatrix *m_pUISectionModMatrix;
+      SamplerGUI::UISectionEngine *m_pUISectionEngine;
+      SamplerGUI::UISectionPart *m_pUISectionPart;
 
       std::vector<juce::TextButton *> m_LayerButtons;
       juce::TextButton *m_pbSolo;
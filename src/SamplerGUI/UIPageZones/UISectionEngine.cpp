@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file UISectionEngine.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class implements the engine UI section
+*/
+/*----------------------------------------------------------------------------*/
+#include <util.h>
+#include "PluginEditor.h"
+#include "UISectionEngine.h"
+
+using namespace SamplerGUI;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+UISectionEngine::UISectionEngine( UIPage *pUIPage ) :
+   UISection( pUIPage, "Engine" ),
+   m_NumUnderruns( 0 )
+{
+   m_plMaxVoices = new juce::Label( "Voices", "Voices:" );
+   addAndMakeVisible( m_plMaxVoices );
+
+   m_psMaxVoices = new juce::Slider( "Voices" );
+   m_psMaxVoices->setRange( 1.0, SAMPLERENGINE_MAXVOICES, 1.0 );
+   m_psMaxVoices->setSliderStyle( juce::Slider::LinearHorizontal );
+   m_psMaxVoices->setTextBoxStyle( juce::Slider::TextBoxBelow, true, 48, 14 );
+   m_psMaxVoices->setSliderSnapsToMousePosition( false );
+   m_psMaxVoices->setLookAndFeel( &m_SliderLAF );
+   m_psMaxVoices->addListener( this );
+   m_psMaxVoices->setColour( juce::Slider::ColourIds::textBoxOutlineColourId, juce::Colour::fromRGBA( 0, 0, 0, 0 ) );
+   addAndMakeVisible( m_psMaxVoices );
+
+   m_plUnderruns = new juce::Label( juce::String(), "Disk underruns: 0" );
+   addAndMakeVisible( m_plUnderruns );
+
+   startTimer( 500 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+UISectionEngine::~UISectionEngine()
+{
+   stopTimer();
+
+   delete m_plMaxVoices;
+   delete m_psMaxVoices;
+   delete m_plUnderruns;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionEngine::paint( juce::Graphics &g )
+{
+   UISection::paint( g );
+
+   g.setColour( juce::Colour::fromRGB( 32, 64, 64 ) );
+   g.fillAll();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionEngine::resized()
+{
+   UISection::resized();
+
+   m_plMaxVoices->setBounds( 0, 32, 64, 12 );
+   m_psMaxVoices->setBounds( 56, 32, 142, 25 );
+   m_plUnderruns->setBounds( 4, 100, 180, 20 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Called when the user has (de-)selected any samples. The engine's settings
+don't depend on them.
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionEngine::samplesUpdated()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Called when the engine's settings may have been replaced, e.g. by importing
+a multi
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionEngine::engineUpdated()
+{
+   m_psMaxVoices->setValue( (double)uiPage()->editor()->processor().samplerEngine()->getMaxVoices(), dontSendNotification );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::Slider::Listener
+\param pSlider The Slider that has changed
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionEngine::sliderValueChanged( Slider *pSlider )
+{
+   if( pSlider == m_psMaxVoices )
+   {
+      uiPage()->editor()->processor().samplerEngine()->setMaxVoices( (size_t)m_psMaxVoices->getValue() );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::Timer, polls the number of disk streaming
+underruns the engine has reported through its EngineHost
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionEngine::timerCallback()
+{
+   uint64_t numUnderruns = uiPage()->editor()->processor().samplerEngine()->host().numUnderruns();
+   if( numUnderruns != m_NumUnderruns )
+   {
+      m_NumUnderruns = numUnderruns;
+      m_plUnderruns->setText( stdformat( "Disk underruns: {}", m_NumUnderruns ), dontSendNotification );
+   }
+}
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file UISectionEngine.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class UISectionEngine.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __UISECTIONENGINE_H__
+#define __UISECTIONENGINE_H__
+
+#include "JuceHeader.h"
+
+#include <SamplerGUI/UISection.h>
+
+class PluginEditor;
+
+//==============================================================================
+namespace SamplerGUI
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class UISectionEngine
+   \date  2026-10-17
+   Settings and status of the whole engine, independent of the selected part
+   and samples.
+   */
+   /*----------------------------------------------------------------------------*/
+   class UISectionEngine : public UISection,
+                           public juce::Slider::Listener,
+                           public juce::Timer
+   {
+   public:
+      UISectionEngine( UIPage *pUIPage );
+      ~UISectionEngine();
+
+      virtual void paint( juce::Graphics &g );
+      virtual void resized();
+      virtual void samplesUpdated();
+      void engineUpdated();
+      virtual void sliderValueChanged( Slider *pSlider );
+      virtual void timerCallback() override;
+
+   protected:
+
+   private:
+      juce::Label *m_plMaxVoices;
+      juce::Slider *m_psMaxVoices;
+      juce::Label *m_plUnderruns;
+      uint64_t m_NumUnderruns;
+   };
+}
+
+#endif
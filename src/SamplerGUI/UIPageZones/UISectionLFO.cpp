@@ -46,7 +46,7 @@ UISectionLFO::StepEditor::StepEditor( UISectionLFO *pSectionLFO ) :
    m_pcNumSteps->setColour( juce::Label::ColourIds::outlineColourId, juce::Colour::fromRGBA( 255, 255, 255, 64 ) );
    m_pcNumSteps->setJustificationType( juce::Justification::centred );
    m_pcNumSteps->setBounds( 38, 91, 32, 18 );
-   m_pcNumSteps->setItems( 1.0, 128, 1.0, "{:.0f}", "" );
+   m_pcNumSteps->setItems( 1.0, LFO_MAXCUSTOMVALUES, 1.0, "{:.0f}", "" );
    m_pcNumSteps->addListener( this );
    addAndMakeVisible( m_pcNumSteps );
 
@@ -0,0 +1,273 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file UISectionPart.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class implements the part UI section
+*/
+/*----------------------------------------------------------------------------*/
+#include "PluginEditor.h"
+#include "UISectionPart.h"
+
+using namespace SamplerGUI;
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+UISectionPart::UISectionPart( UIPage *pUIPage ) :
+   UISection( pUIPage, "Part" )
+{
+   m_pcbInterpolation = new juce::ComboBox( "Interpolation" );
+   for( SamplerEngine::SampleReader::Interpolation i : SamplerEngine::SampleReader::allInterpolations() )
+   {
+      m_pcbInterpolation->addItem( SamplerEngine::SampleReader::toString( i ), i );
+   }
+   m_pcbInterpolation->addListener( this );
+   addAndMakeVisible( m_pcbInterpolation );
+
+   m_pcbVoiceStealing = new juce::ComboBox( "Voice Stealing" );
+   for( SamplerEngine::Part::VoiceStealing mode : SamplerEngine::Part::allVoiceStealingModes() )
+   {
+      m_pcbVoiceStealing->addItem( SamplerEngine::Part::toString( mode ), mode );
+   }
+   m_pcbVoiceStealing->addListener( this );
+   addAndMakeVisible( m_pcbVoiceStealing );
+
+   m_plModRate = new juce::Label( "Mod Rate", "Mod rate:" );
+   addAndMakeVisible( m_plModRate );
+
+   m_psModRate = new juce::Slider( "Mod Rate" );
+   m_psModRate->setRange( VOICE_MIN_MODRATE, VOICE_MAX_MODRATE, 1.0 );
+   m_psModRate->setSkewFactorFromMidPoint( 1000.0 );
+   m_psModRate->setSliderStyle( juce::Slider::LinearHorizontal );
+   m_psModRate->setTextValueSuffix( "Hz" );
+   m_psModRate->setTextBoxStyle( juce::Slider::TextBoxBelow, true, 64, 14 );
+   m_psModRate->setSliderSnapsToMousePosition( false );
+   m_psModRate->setLookAndFeel( &m_SliderLAF );
+   m_psModRate->addListener( this );
+   m_psModRate->setColour( juce::Slider::ColourIds::textBoxOutlineColourId, juce::Colour::fromRGBA( 0, 0, 0, 0 ) );
+   addAndMakeVisible( m_psModRate );
+
+   m_plMaxVoices = new juce::Label( "Voices", "Voices:" );
+   addAndMakeVisible( m_plMaxVoices );
+
+   m_psMaxVoices = new juce::Slider( "Voices" );
+   m_psMaxVoices->setRange( 1.0, SAMPLERENGINE_MAXVOICESPERPART, 1.0 );
+   m_psMaxVoices->setSliderStyle( juce::Slider::LinearHorizontal );
+   m_psMaxVoices->setTextBoxStyle( juce::Slider::TextBoxBelow, true, 48, 14 );
+   m_psMaxVoices->setSliderSnapsToMousePosition( false );
+   m_psMaxVoices->setLookAndFeel( &m_SliderLAF );
+   m_psMaxVoices->addListener( this );
+   m_psMaxVoices->setColour( juce::Slider::ColourIds::textBoxOutlineColourId, juce::Colour::fromRGBA( 0, 0, 0, 0 ) );
+   addAndMakeVisible( m_psMaxVoices );
+
+   m_pbAudioRatePitch = new juce::TextButton( "AR Pitch" );
+   m_pbAudioRatePitch->setToggleable( true );
+   m_pbAudioRatePitch->setClickingTogglesState( true );
+   m_pbAudioRatePitch->setColour( juce::TextButton::ColourIds::buttonOnColourId, juce::Colour::fromRGB( 192, 64, 64 ) );
+   m_pbAudioRatePitch->setTooltip( "Modulate the pitch at audio rate" );
+   m_pbAudioRatePitch->addListener( this );
+   addAndMakeVisible( m_pbAudioRatePitch );
+
+   m_pbAudioRateCutoff = new juce::TextButton( "AR Cutoff" );
+   m_pbAudioRateCutoff->setToggleable( true );
+   m_pbAudioRateCutoff->setClickingTogglesState( true );
+   m_pbAudioRateCutoff->setColour( juce::TextButton::ColourIds::buttonOnColourId, juce::Colour::fromRGB( 192, 64, 64 ) );
+   m_pbAudioRateCutoff->setTooltip( "Modulate the filter cutoff at audio rate" );
+   m_pbAudioRateCutoff->addListener( this );
+   addAndMakeVisible( m_pbAudioRateCutoff );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+UISectionPart::~UISectionPart()
+{
+   delete m_pcbInterpolation;
+   delete m_pcbVoiceStealing;
+   delete m_plModRate;
+   delete m_psModRate;
+   delete m_plMaxVoices;
+   delete m_psMaxVoices;
+   delete m_pbAudioRatePitch;
+   delete m_pbAudioRateCutoff;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The part currently selected in the editor
+*/
+/*----------------------------------------------------------------------------*/
+SamplerEngine::Part *UISectionPart::part() const
+{
+   return( uiPage()->editor()->processor().samplerEngine()->getPart( uiPage()->editor()->currentPart() ) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::paint( juce::Graphics &g )
+{
+   UISection::paint( g );
+
+   g.setColour( juce::Colour::fromRGB( 32, 64, 64 ) );
+   g.fillAll();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::resized()
+{
+   UISection::resized();
+
+   m_pcbInterpolation->setBounds( 4, 24, 96, 20 );
+   m_pcbVoiceStealing->setBounds( 104, 24, 96, 20 );
+   m_plModRate->setBounds( 0, 52, 64, 12 );
+   m_psModRate->setBounds( 56, 52, 142, 25 );
+   m_plMaxVoices->setBounds( 0, 82, 64, 12 );
+   m_psMaxVoices->setBounds( 56, 82, 142, 25 );
+   m_pbAudioRatePitch->setBounds( 4, 110, 96, 20 );
+   m_pbAudioRateCutoff->setBounds( 104, 110, 96, 20 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Called when the user has (de-)selected any samples. The part's settings
+don't depend on them.
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::samplesUpdated()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Called when another part has been selected or the current part has been
+replaced, e.g. by importing a program
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::partUpdated()
+{
+   const SamplerEngine::Part *pPart = part();
+   if( !pPart )
+      return;
+
+   m_pcbInterpolation->setSelectedId( pPart->getInterpolation(), dontSendNotification );
+   m_pcbVoiceStealing->setSelectedId( pPart->getVoiceStealing(), dontSendNotification );
+   m_psModRate->setValue( pPart->getModulationRate(), dontSendNotification );
+   m_psMaxVoices->setValue( (double)pPart->getMaxVoices(), dontSendNotification );
+   m_pbAudioRatePitch->setToggleState( pPart->isAudioRateModulation( SamplerEngine::ModMatrix::ModDest_Pitch ), dontSendNotification );
+   m_pbAudioRateCutoff->setToggleState( pPart->isAudioRateModulation( SamplerEngine::ModMatrix::ModDest_FilterCutoff ), dontSendNotification );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::Slider::Listener
+\param pSlider The Slider that has changed
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::sliderValueChanged( Slider *pSlider )
+{
+   SamplerEngine::Part *pPart = part();
+   if( !pPart )
+      return;
+
+   if( pSlider == m_psModRate )
+   {
+      pPart->setModulationRate( m_psModRate->getValue() );
+   } else
+   if( pSlider == m_psMaxVoices )
+   {
+      pPart->setMaxVoices( (size_t)m_psMaxVoices->getValue() );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::Button::Listener
+\param pButton The Button that has been clicked
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::buttonClicked( Button *pButton )
+{
+   SamplerEngine::Part *pPart = part();
+   if( !pPart )
+      return;
+
+   if( pButton == m_pbAudioRatePitch )
+   {
+      pPart->setAudioRateModulation( SamplerEngine::ModMatrix::ModDest_Pitch, m_pbAudioRatePitch->getToggleState() );
+   } else
+   if( pButton == m_pbAudioRateCutoff )
+   {
+      pPart->setAudioRateModulation( SamplerEngine::ModMatrix::ModDest_FilterCutoff, m_pbAudioRateCutoff->getToggleState() );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::Button::Listener
+\param pButton The Button whose state has changed
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::buttonStateChanged( Button */*pButton*/ )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::ComboBox::Listener
+\param pComboBox The ComboBox that has changed
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionPart::comboBoxChanged( ComboBox *pComboBox )
+{
+   SamplerEngine::Part *pPart = part();
+   if( !pPart )
+      return;
+
+   if( pComboBox == m_pcbInterpolation )
+   {
+      pPart->setInterpolation( (SamplerEngine::SampleReader::Interpolation)m_pcbInterpolation->getSelectedId() );
+   } else
+   if( pComboBox == m_pcbVoiceStealing )
+   {
+      pPart->setVoiceStealing( (SamplerEngine::Part::VoiceStealing)m_pcbVoiceStealing->getSelectedId() );
+   }
+}
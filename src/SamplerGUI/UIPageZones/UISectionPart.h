@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file UISectionPart.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class UISectionPart.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __UISECTIONPART_H__
+#define __UISECTIONPART_H__
+
+#include "JuceHeader.h"
+
+#include <SamplerGUI/UISection.h>
+
+class PluginEditor;
+
+//==============================================================================
+namespace SamplerGUI
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class UISectionPart
+   \date  2026-10-17
+   Settings of the current part which trade CPU for quality: the interpolation
+   kernel, the modulation rate, audio-rate modulation and the voice limit.
+   */
+   /*----------------------------------------------------------------------------*/
+   class UISectionPart : public UISection,
+                         public juce::Slider::Listener,
+                         public juce::Button::Listener,
+                         public juce::ComboBox::Listener
+   {
+   public:
+      UISectionPart( UIPage *pUIPage );
+      ~UISectionPart();
+
+      virtual void paint( juce::Graphics &g );
+      virtual void resized();
+
+      virtual void samplesUpdated();
+      void partUpdated();
+
+      virtual void sliderValueChanged( Slider *pSlider );
+      virtual void buttonClicked( Button *pButton );
+      virtual void buttonStateChanged( Button *pButton );
+      virtual void comboBoxChanged( ComboBox *pComboBox );
+
+   protected:
+      SamplerEngine::Part *part() const;
+
+   private:
+      juce::ComboBox *m_pcbInterpolation;
+      juce::ComboBox *m_pcbVoiceStealing;
+      juce::Label *m_plModRate;
+      juce::Slider *m_psModRate;
+      juce::Label *m_plMaxVoices;
+      juce::Slider *m_psMaxVoices;
+      juce::TextButton *m_pbAudioRatePitch;
+      juce::TextButton *m_pbAudioRateCutoff;
+   };
+}
+
+#endif
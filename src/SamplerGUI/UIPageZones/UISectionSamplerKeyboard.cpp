@@ -48,6 +48,10 @@ UISectionSamplerKeyboard::UISectionSamplerKeyboard( UIPageZones *pPageZones ) :
    m_CurrentSampleNoteOffset( 0 ),
    m_CurrentSampleHandle( -1 ),
    m_DragDropNote( -1 ),
+   m_pLoader( nullptr ),
+   m_LoadPart( 0 ),
+   m_LoadNote( -1 ),
+   m_LoadLayer( 0 ),
    m_SelectionStartPoint( juce::Point<int>( 0, 0 ) ),
    m_SelectionRectangle( juce::Rectangle<int>( 0, 0, 0, 0 ) ),
    m_Selecting( false ),
@@ -63,6 +67,8 @@ Destructor
 /*----------------------------------------------------------------------------*/
 UISectionSamplerKeyboard::~UISectionSamplerKeyboard()
 {
+   stopTimer();
+   delete m_pLoader;
 }
 
 
@@ -268,6 +274,18 @@ void UISectionSamplerKeyboard::paint( juce::Graphics &g )
       g.drawText( noteName( m_DragDropNote ), m_Width, r.getY(), getBounds().getWidth() - m_Width, m_KeyHeight / 2, juce::Justification::centred);
    }
 
+   if( m_pLoader )
+   {
+      int w = getBounds().getWidth() - m_Width;
+      juce::Rectangle<int> r( m_Width, 0, w, m_KeyHeight );
+      g.setColour( juce::Colour::fromRGBA( 0, 0, 0, 192 ) );
+      g.fillRect( r );
+      g.setColour( juce::Colour::fromRGB( 128, 64, 64 ) );
+      g.fillRect( r.withWidth( (int)( w * m_pLoader->getProgress() ) ) );
+      g.setColour( juce::Colour::fromRGB( 255, 255, 255 ) );
+      g.drawText( "Loading " + std::to_string( m_pLoader->numDone() ) + " / " + std::to_string( m_pLoader->numJobs() ), r, juce::Justification::centred );
+   }
+
    if( m_Selecting )
    {
       juce::Rectangle<int> r = m_SelectionRectangle;
@@ -327,6 +345,9 @@ Callback function from juce::FileDragAndDropTarget
 /*----------------------------------------------------------------------------*/
 bool UISectionSamplerKeyboard::isInterestedInFileDrag( const StringArray &files )
 {
+   if( m_pLoader )
+      return( false );
+
    for( String f : files )
    {
       if( !juce::String( util::toLower( f.toStdString() ) ).endsWith( ".wav" ) )
@@ -409,20 +430,83 @@ Callback function from juce::FileDragAndDropTarget
 /*----------------------------------------------------------------------------*/
 void UISectionSamplerKeyboard::filesDropped( const StringArray &files, int /*x*/, int /*y*/ )
 {
-   int n = 0;
+   if( m_pLoader )
+      return;
+
+   SamplerEngine::WaveFile::LoadMode loadMode = m_pPageZones->editor()->processor().samplerEngine()->getSampleLoadMode();
+
+   m_pLoader = new SamplerEngine::SampleLoader();
    for( String f : files )
    {
-      SamplerEngine::WaveFile *pWave = SamplerEngine::WaveFile::load( f.toStdString() );
+      m_pLoader->addFile( f.toStdString(), loadMode );
+   }
+
+   m_LoadPart = m_pPageZones->editor()->currentPart();
+   m_LoadNote = m_DragDropNote;
+   m_LoadLayer = m_pPageZones->getCurrentLayer();
+   m_pLoader->start();
+   startTimer( 50 );
+
+   m_DragDropNote = -1;
+   repaint();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Callback function from juce::Timer, polls the progress of a running load
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionSamplerKeyboard::timerCallback()
+{
+   if( m_pLoader && m_pLoader->isFinished() )
+   {
+      finishLoading();
+   }
+
+   repaint();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Create samples from all wave files loaded by the SampleLoader and add them to
+the part they have been dropped onto at once. The samples are mapped to
+consecutive notes starting at the drop position, in the order of the files.
+*/
+/*----------------------------------------------------------------------------*/
+void UISectionSamplerKeyboard::finishLoading()
+{
+   stopTimer();
+   m_pLoader->wait();
+
+   std::list<SamplerEngine::Sample *> newSamples;
+   int n = 0;
+   for( size_t i = 0; i < m_pLoader->numJobs(); i++ )
+   {
+      SamplerEngine::WaveFile *pWave = m_pLoader->takeWave( i );
       if( pWave )
       {
-         SamplerEngine::Sample *pSample = new SamplerEngine::Sample( std::filesystem::path( f.toStdString() ).stem().string(), pWave, m_DragDropNote + n, m_DragDropNote + n, m_pPageZones->getCurrentLayer() );
-         samples().push_back( pSample );
+         SamplerEngine::Sample *pSample = new SamplerEngine::Sample( std::filesystem::path( m_pLoader->getFileName( i ) ).stem().string(), pWave, m_LoadNote + n, m_LoadNote + n, m_LoadLayer );
+         newSamples.push_back( pSample );
          n++;
       }
    }
 
-   m_DragDropNote = -1;
-   repaint();
+   SamplerEngine::Part *pPart = m_pPageZones->editor()->processor().samplerEngine()->getPart( m_LoadPart );
+   if( pPart )
+   {
+      pPart->addSamples( newSamples );
+   } else
+   {
+      for( SamplerEngine::Sample *pSample : newSamples )
+      {
+         delete pSample;
+      }
+   }
+
+   delete m_pLoader;
+   m_pLoader = nullptr;
 }
 
 
@@ -836,6 +920,12 @@ void UISectionSamplerKeyboard::mouseUp( const MouseEvent &event )
    } else
    if( m_CurrentSampleNote >= 0 )
    {
+      SamplerEngine::Part *pPart = m_pPageZones->editor()->processor().samplerEngine()->getPart( m_pPageZones->editor()->currentPart() );
+      if( pPart )
+      {
+         pPart->beginZoneChanges();
+      }
+
       for( SamplerEngine::Sample *pSample : m_SelectedSamples )
       {
          pSample->setMinNote( pSample->getMinNote() + m_CurrentSampleNoteOffset );
@@ -844,6 +934,11 @@ void UISectionSamplerKeyboard::mouseUp( const MouseEvent &event )
          emitSampleSelectionUpdated();
       }
 
+      if( pPart )
+      {
+         pPart->endZoneChanges();
+      }
+
       m_CurrentSampleNote = -1;
       m_CurrentSampleNoteOffset = 0;
    }
@@ -31,6 +31,7 @@
 #include <set>
 
 #include <SamplerEngine/Sample.h>
+#include <SamplerEngine/SampleLoader.h>
 
 #include "JuceHeader.h"
 #include "UISectionKeyboard.h"
@@ -63,7 +64,8 @@ namespace SamplerGUI
    /*----------------------------------------------------------------------------*/
    class UISectionSamplerKeyboard : public UISectionKeyboard,
                                     public juce::FileDragAndDropTarget,
-                                    public juce::KeyListener
+                                    public juce::KeyListener,
+                                    public juce::Timer
 
    {
    public:
@@ -98,6 +100,8 @@ namespace SamplerGUI
       virtual void fileDragExit( const StringArray &files );
       virtual void filesDropped( const StringArray &files, int x, int y );
 
+      virtual void timerCallback() override;
+
       std::set<SamplerEngine::Sample *> selectedSamples() const;
       void clearSelectedSamples();
       void selectAll();
@@ -116,6 +120,7 @@ namespace SamplerGUI
       void emitSampleSelectionUpdated();
       void emitDeleteSample( size_t nPart, SamplerEngine::Sample *pSample );
       void deleteSelectedSamples();
+      void finishLoading();
 
    private:
       std::set<SamplerEngine::Sample *> m_SelectedSamples;
@@ -129,6 +134,11 @@ namespace SamplerGUI
 
       int m_DragDropNote;
 
+      SamplerEngine::SampleLoader *m_pLoader;
+      size_t m_LoadPart;
+      int m_LoadNote;
+      int m_LoadLayer;
+
       juce::Point<int> m_SelectionStartPoint;
       juce::Rectangle<int> m_SelectionRectangle;
       bool m_Selecting;
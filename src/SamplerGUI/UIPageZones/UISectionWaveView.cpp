@@ -175,7 +175,7 @@ void UISectionWaveView::paint( juce::Graphics &g )
 
       g.drawText( stdformat( "{:.1f}kHz", (float)pWave->sampleRate() / 1000.0 ),
          500, totalHeight + 8, 128, 14, juce::Justification::left );
-      g.drawText( stdformat( "{}bit {}ch", pWave->numBits(), pWave->numChannels() ),
+      g.drawText( stdformat( "{} {}ch", SamplerEngine::SampleReader::toString( pWave->sampleFormat() ), pWave->numChannels() ),
          560, totalHeight + 8, 128, 14, juce::Justification::left );
 
       g.setColour( juce::Colour::fromRGB( 255, 255, 0 ) );
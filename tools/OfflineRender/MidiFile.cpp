@@ -0,0 +1,302 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file MidiFile.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class reads Standard MIDI Files
+*/
+/*----------------------------------------------------------------------------*/
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include "MidiFile.h"
+
+using namespace OfflineRender;
+
+#define MIDIFILE_DEFAULTTEMPO 500000
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+MidiFile::MidiFile() :
+   m_Length( 0.0 ),
+   m_InitialBpm( 120.0 )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+MidiFile::~MidiFile()
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return All channel voice messages in chronological order
+*/
+/*----------------------------------------------------------------------------*/
+const std::vector<MidiEvent> &MidiFile::events() const
+{
+   return( m_Events );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The time of the last event in seconds
+*/
+/*----------------------------------------------------------------------------*/
+double MidiFile::length() const
+{
+   return( m_Length );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The tempo at the beginning of the file
+*/
+/*----------------------------------------------------------------------------*/
+double MidiFile::initialBpm() const
+{
+   return( m_InitialBpm );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Read a variable-length quantity.
+\param pData The track data
+\param size The size of the track data
+\param pos The read position, advanced past the value
+\param value Receives the value
+\return false if the track data ends prematurely
+*/
+/*----------------------------------------------------------------------------*/
+bool MidiFile::readVarLen( const uint8_t *pData, size_t size, size_t &pos, uint32_t &value )
+{
+   value = 0;
+
+   for( int i = 0; i < 4; i++ )
+   {
+      if( pos >= size )
+         return( false );
+
+      uint8_t b = pData[pos++];
+      value = ( value << 7 ) | ( b & 0x7f );
+      if( !( b & 0x80 ) )
+         return( true );
+   }
+
+   return( false );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Parse the events of one track chunk.
+\param pData The track data
+\param size The size of the track data
+\param events Receives the channel voice messages and tempo changes
+\return false if the track data is malformed
+*/
+/*----------------------------------------------------------------------------*/
+bool MidiFile::readTrack( const uint8_t *pData, size_t size, std::vector<TrackEvent> &events )
+{
+   uint64_t tick = 0;
+   uint8_t runningStatus = 0;
+   size_t pos = 0;
+
+   while( pos < size )
+   {
+      uint32_t delta;
+      if( !readVarLen( pData, size, pos, delta ) || pos >= size )
+         return( false );
+      tick += delta;
+
+      uint8_t status = pData[pos];
+      if( status & 0x80 )
+      {
+         pos++;
+      } else
+      {
+         status = runningStatus;
+      }
+
+      if( status == 0xff )
+      {
+         // Meta event
+         if( pos >= size )
+            return( false );
+         uint8_t type = pData[pos++];
+         uint32_t len;
+         if( !readVarLen( pData, size, pos, len ) || pos + len > size )
+            return( false );
+
+         if( type == 0x51 && len == 3 )
+         {
+            TrackEvent e = {};
+            e.tick = tick;
+            e.tempo = ( (uint32_t)pData[pos] << 16 ) | ( (uint32_t)pData[pos + 1] << 8 ) | pData[pos + 2];
+            events.push_back( e );
+         } else
+         if( type == 0x2f )
+         {
+            return( true );
+         }
+         pos += len;
+      } else
+      if( status == 0xf0 || status == 0xf7 )
+      {
+         // SysEx
+         uint32_t len;
+         if( !readVarLen( pData, size, pos, len ) || pos + len > size )
+            return( false );
+         pos += len;
+         runningStatus = 0;
+      } else
+      if( status >= 0x80 && status < 0xf0 )
+      {
+         size_t nData = ( ( status & 0xf0 ) == 0xc0 || ( status & 0xf0 ) == 0xd0 ) ? 1 : 2;
+         if( pos + nData > size )
+            return( false );
+
+         TrackEvent e = {};
+         e.tick = tick;
+         e.event.status = status;
+         e.event.data1 = pData[pos] & 0x7f;
+         e.event.data2 = nData > 1 ? pData[pos + 1] & 0x7f : 0;
+         events.push_back( e );
+
+         pos += nData;
+         runningStatus = status;
+      } else
+      {
+         return( false );
+      }
+   }
+
+   return( true );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Load a Standard MIDI File.
+\param fileName The file name
+\return The MIDI file or nullptr if it couldn't be read
+*/
+/*----------------------------------------------------------------------------*/
+MidiFile *MidiFile::load( const std::string &fileName )
+{
+   std::ifstream file( fileName, std::ios::binary );
+   if( !file.is_open() )
+      return( nullptr );
+
+   std::vector<uint8_t> data( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+   if( data.size() < 14 || std::string( (const char *)data.data(), 4 ) != "MThd" )
+      return( nullptr );
+
+   auto getWord = [&data]( size_t pos ) { return( (uint32_t)( ( data[pos] << 8 ) | data[pos + 1] ) ); };
+   auto getDWord = [&data]( size_t pos ) { return( (uint32_t)( ( data[pos] << 24 ) | ( data[pos + 1] << 16 ) | ( data[pos + 2] << 8 ) | data[pos + 3] ) ); };
+
+   uint32_t headerSize = getDWord( 4 );
+   uint32_t format = getWord( 8 );
+   uint32_t division = getWord( 12 );
+   bool smpte = ( division & 0x8000 ) != 0;
+   if( headerSize < 6 || format > 1 || ( division & 0x7fff ) == 0 )
+      return( nullptr );
+   if( smpte && ( ( division >> 8 ) == 0x80 || ( division & 0xff ) == 0 ) )
+      return( nullptr );
+
+   std::vector<TrackEvent> events;
+   size_t pos = 8 + headerSize;
+   while( pos + 8 <= data.size() )
+   {
+      uint32_t chunkSize = getDWord( pos + 4 );
+      if( pos + 8 + chunkSize > data.size() )
+         return( nullptr );
+
+      if( std::string( (const char *)data.data() + pos, 4 ) == "MTrk" )
+      {
+         if( !readTrack( data.data() + pos + 8, chunkSize, events ) )
+            return( nullptr );
+      }
+      pos += 8 + chunkSize;
+   }
+
+   // Merge the tracks. Tempo changes take effect before other events at the
+   // same tick, otherwise the order within the file is kept.
+   for( size_t i = 0; i < events.size(); i++ )
+   {
+      events[i].order = i;
+   }
+   std::sort( events.begin(), events.end(), []( const TrackEvent &a, const TrackEvent &b )
+   {
+      if( a.tick != b.tick )
+         return( a.tick < b.tick );
+      if( ( a.tempo != 0 ) != ( b.tempo != 0 ) )
+         return( a.tempo != 0 );
+      return( a.order < b.order );
+   } );
+
+   MidiFile *pMidiFile = new MidiFile();
+
+   uint32_t tempo = MIDIFILE_DEFAULTTEMPO;
+   uint64_t lastTick = 0;
+   double time = 0.0;
+   double secondsPerTick = smpte ?
+      1.0 / ( (double)( -(int8_t)( division >> 8 ) ) * (double)( division & 0xff ) ) :
+      (double)tempo / 1000000.0 / (double)division;
+
+   for( const TrackEvent &e : events )
+   {
+      time += (double)( e.tick - lastTick ) * secondsPerTick;
+      lastTick = e.tick;
+
+      if( e.tempo != 0 )
+      {
+         tempo = e.tempo;
+         if( !smpte )
+            secondsPerTick = (double)tempo / 1000000.0 / (double)division;
+         if( e.tick == 0 )
+            pMidiFile->m_InitialBpm = 60000000.0 / (double)tempo;
+      } else
+      {
+         MidiEvent me = e.event;
+         me.time = time;
+         me.bpm = 60000000.0 / (double)tempo;
+         pMidiFile->m_Events.push_back( me );
+      }
+   }
+   pMidiFile->m_Length = time;
+
+   return( pMidiFile );
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file MidiFile.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class MidiFile.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __MIDIFILE_H__
+#define __MIDIFILE_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+//==============================================================================
+namespace OfflineRender
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \struct MidiEvent
+   \date  2026-10-17
+   A channel voice message with its time and the tempo in effect.
+   */
+   /*----------------------------------------------------------------------------*/
+   struct MidiEvent
+   {
+      double time;
+      double bpm;
+      uint8_t status;
+      uint8_t data1;
+      uint8_t data2;
+   };
+
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class MidiFile
+   \date  2026-10-17
+   A Standard MIDI File (format 0 or 1), reduced to the channel voice
+   messages of all tracks in chronological order.
+   */
+   /*----------------------------------------------------------------------------*/
+   class MidiFile
+   {
+   public:
+      ~MidiFile();
+
+      static MidiFile *load( const std::string &fileName );
+
+      const std::vector<MidiEvent> &events() const;
+      double length() const;
+      double initialBpm() const;
+
+   private:
+      MidiFile();
+
+      struct TrackEvent
+      {
+         uint64_t tick;
+         size_t order;
+         uint32_t tempo;
+         MidiEvent event;
+      };
+
+      static bool readTrack( const uint8_t *pData, size_t size, std::vector<TrackEvent> &events );
+      static bool readVarLen( const uint8_t *pData, size_t size, size_t &pos, uint32_t &value );
+
+   private:
+      std::vector<MidiEvent> m_Events;
+      double m_Length;
+      double m_InitialBpm;
+   };
+}
+
+#endif
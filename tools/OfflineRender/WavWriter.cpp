@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file WavWriter.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief This class writes WAV files
+*/
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "WavWriter.h"
+
+using namespace OfflineRender;
+
+#define WAVWRITER_FORMAT_IEEE_FLOAT 3
+#define WAVWRITER_NUMCHANNELS 2
+#define WAVWRITER_HEADERSIZE 44
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Constructor
+*/
+/*----------------------------------------------------------------------------*/
+WavWriter::WavWriter() :
+   m_SampleRate( 0 ),
+   m_NumSamples( 0 )
+{
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Destructor
+*/
+/*----------------------------------------------------------------------------*/
+WavWriter::~WavWriter()
+{
+   close();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Create the file and write a preliminary header.
+\param fileName The file name
+\param sampleRate The sample rate in Hz
+\return false if the file couldn't be created
+*/
+/*----------------------------------------------------------------------------*/
+bool WavWriter::open( const std::string &fileName, uint32_t sampleRate )
+{
+   m_File.open( fileName, std::ios::binary | std::ios::trunc );
+   if( !m_File.is_open() )
+      return( false );
+
+   m_SampleRate = sampleRate;
+   m_NumSamples = 0;
+   writeHeader();
+
+   return( m_File.good() );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Append stereo frames.
+\param pLeft The left channel
+\param pRight The right channel
+\param n The number of frames
+*/
+/*----------------------------------------------------------------------------*/
+void WavWriter::write( const float *pLeft, const float *pRight, size_t n )
+{
+   for( size_t i = 0; i < n; i++ )
+   {
+      float frame[WAVWRITER_NUMCHANNELS] = { pLeft[i], pRight[i] };
+      uint8_t bytes[sizeof( frame )];
+
+      // WAV data is little endian
+      for( size_t c = 0; c < WAVWRITER_NUMCHANNELS; c++ )
+      {
+         uint32_t v;
+         memcpy( &v, &frame[c], sizeof( v ) );
+         bytes[( c * 4 ) + 0] = (uint8_t)v;
+         bytes[( c * 4 ) + 1] = (uint8_t)( v >> 8 );
+         bytes[( c * 4 ) + 2] = (uint8_t)( v >> 16 );
+         bytes[( c * 4 ) + 3] = (uint8_t)( v >> 24 );
+      }
+      m_File.write( (const char *)bytes, sizeof( bytes ) );
+   }
+
+   m_NumSamples += n;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Write the final header and close the file.
+\return false if writing the file failed
+*/
+/*----------------------------------------------------------------------------*/
+bool WavWriter::close()
+{
+   if( !m_File.is_open() )
+      return( true );
+
+   m_File.seekp( 0 );
+   writeHeader();
+
+   bool ok = m_File.good();
+   m_File.close();
+
+   return( ok );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\return The number of frames written so far
+*/
+/*----------------------------------------------------------------------------*/
+uint64_t WavWriter::numSamples() const
+{
+   return( m_NumSamples );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Write the RIFF header for the number of frames written so far.
+*/
+/*----------------------------------------------------------------------------*/
+void WavWriter::writeHeader()
+{
+   const uint32_t blockAlign = WAVWRITER_NUMCHANNELS * sizeof( float );
+   const uint32_t dataSize = (uint32_t)( m_NumSamples * blockAlign );
+
+   m_File.write( "RIFF", 4 );
+   writeDWord( WAVWRITER_HEADERSIZE - 8 + dataSize );
+   m_File.write( "WAVE", 4 );
+
+   m_File.write( "fmt ", 4 );
+   writeDWord( 16 );
+   writeWord( WAVWRITER_FORMAT_IEEE_FLOAT );
+   writeWord( WAVWRITER_NUMCHANNELS );
+   writeDWord( m_SampleRate );
+   writeDWord( m_SampleRate * blockAlign );
+   writeWord( (uint16_t)blockAlign );
+   writeWord( 32 );
+
+   m_File.write( "data", 4 );
+   writeDWord( dataSize );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param v A 32bit value to be written in little endian byte order
+*/
+/*----------------------------------------------------------------------------*/
+void WavWriter::writeDWord( uint32_t v )
+{
+   const char bytes[4] = { (char)v, (char)( v >> 8 ), (char)( v >> 16 ), (char)( v >> 24 ) };
+   m_File.write( bytes, 4 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param v A 16bit value to be written in little endian byte order
+*/
+/*----------------------------------------------------------------------------*/
+void WavWriter::writeWord( uint16_t v )
+{
+   const char bytes[2] = { (char)v, (char)( v >> 8 ) };
+   m_File.write( bytes, 2 );
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file WavWriter.h
+\author Christian Nowak <chnowak@web.de>
+\brief Headerfile for class WavWriter.
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef __WAVWRITER_H__
+#define __WAVWRITER_H__
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+
+//==============================================================================
+namespace OfflineRender
+{
+   /*----------------------------------------------------------------------------*/
+   /*!
+   \class WavWriter
+   \date  2026-10-17
+   Writes a stereo WAV file with 32bit float samples.
+   */
+   /*----------------------------------------------------------------------------*/
+   class WavWriter
+   {
+   public:
+      WavWriter();
+      ~WavWriter();
+
+      bool open( const std::string &fileName, uint32_t sampleRate );
+      void write( const float *pLeft, const float *pRight, size_t n );
+      bool close();
+
+      uint64_t numSamples() const;
+
+   private:
+      void writeHeader();
+      void writeDWord( uint32_t v );
+      void writeWord( uint16_t v );
+
+   private:
+      std::ofstream m_File;
+      uint32_t m_SampleRate;
+      uint64_t m_NumSamples;
+   };
+}
+
+#endif
@@ -0,0 +1,339 @@
+/*******************************************************************************
+ *  Copyright (c) 2024 Christian Nowak <chnowak@web.de>                        *
+ *   This file is part of chn's Overvoltage.                                   *
+ *                                                                             *
+ *  Overvoltage is free software: you can redistribute it and/or modify it     *
+ *  under the terms of the GNU General Public License as published by the Free *
+ *  Software Foundation, either version 3 of the License, or (at your option)  *
+ *  any later version.                                                         *
+ *                                                                             *          
+ *  Overvoltage is distributed in the hope that it will be useful, but         * 
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ *  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License    *
+ *  for more details.                                                          *
+ *                                                                             *
+ *  You should have received a copy of the GNU General Public License along    *
+ *  with Overvoltage. If not, see <https://www.gnu.org/licenses/>.             *
+ *******************************************************************************/
+
+
+/*----------------------------------------------------------------------------*/
+/*!
+\file main.cpp
+\author Christian Nowak <chnowak@web.de>
+\brief Command line tool for rendering a Standard MIDI File through a multi
+exported from Overvoltage into WAV files, without a plugin host.
+*/
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libxml/parser.h>
+#include <SamplerEngine/SamplerEngine.h>
+
+#include "MidiFile.h"
+#include "WavWriter.h"
+
+using namespace OfflineRender;
+
+#define OFFLINERENDER_DEFAULTSAMPLERATE 44100
+#define OFFLINERENDER_DEFAULTBLOCKSIZE 512
+#define OFFLINERENDER_DEFAULTTAIL 10.0
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Print the command line syntax.
+*/
+/*----------------------------------------------------------------------------*/
+static void usage()
+{
+   fprintf( stderr,
+      "Usage: OvervoltageRender [options] <multi.xml> <song.mid> <output.wav>\n"
+      "\n"
+      "Options:\n"
+      "  --samplerate <Hz>   Output sample rate (default %d)\n"
+      "  --blocksize <n>     Samples per processing block (default %d)\n"
+      "  --threads <n>       Render threads, overrides the multi's setting\n"
+      "  --tail <seconds>    Maximum time to render after the last MIDI event,\n"
+      "                      rendering stops earlier once all voices are done\n"
+      "                      (default %.0f)\n"
+      "  --stems             Write one file per output bus (<output>-<n>.wav)\n"
+      "                      instead of a mixdown of all buses\n",
+      OFFLINERENDER_DEFAULTSAMPLERATE, OFFLINERENDER_DEFAULTBLOCKSIZE, OFFLINERENDER_DEFAULTTAIL );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Load a multi exported from Overvoltage.
+\param fileName The XML file
+\return The engine or nullptr if the file couldn't be loaded
+*/
+/*----------------------------------------------------------------------------*/
+static SamplerEngine::Engine *loadMulti( const std::string &fileName )
+{
+   xmlDocPtr doc = xmlReadFile( fileName.c_str(), nullptr, XML_PARSE_HUGE );
+   if( !doc )
+      return( nullptr );
+
+   SamplerEngine::Engine *pEngine = nullptr;
+   xmlNode *pRoot = xmlDocGetRootElement( doc );
+   if( pRoot )
+   {
+      pEngine = SamplerEngine::Engine::fromXml( pRoot );
+   }
+   xmlFreeDoc( doc );
+
+   return( pEngine );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Pass a MIDI event to the engine, the same way PluginProcessor does.
+\param pEngine The engine
+\param e The MIDI event
+*/
+/*----------------------------------------------------------------------------*/
+static void applyEvent( SamplerEngine::Engine *pEngine, const MidiEvent &e )
+{
+   size_t nPart = e.status & 0x0f;
+   uint8_t type = e.status & 0xf0;
+
+   if( type == 0x90 && e.data2 > 0 )
+   {
+      pEngine->noteOn( nPart, e.data1, e.data2 );
+   } else
+   if( type == 0x80 || type == 0x90 )
+   {
+      pEngine->noteOff( nPart, e.data1, e.data2 );
+   } else
+   if( type == 0xe0 )
+   {
+      int pitchValue = e.data1 | ( e.data2 << 7 );
+      pEngine->pitchbend( nPart, ( 2.0 * ( (double)pitchValue / (double)0x3fff ) ) - 1.0 );
+   } else
+   if( type == 0xb0 )
+   {
+      pEngine->controllerChange( nPart, e.data1, (double)e.data2 / 127.0 );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+\param fileName The output file name given on the command line
+\param nBus The output bus
+\return The file name of the bus' stem
+*/
+/*----------------------------------------------------------------------------*/
+static std::string stemFileName( const std::string &fileName, size_t nBus )
+{
+   std::string base = fileName;
+   size_t dot = base.find_last_of( '.' );
+   size_t sep = base.find_last_of( "/\\" );
+   if( dot != std::string::npos && ( sep == std::string::npos || dot > sep ) )
+   {
+      base = base.substr( 0, dot );
+   }
+
+   return( base + "-" + std::to_string( nBus + 1 ) + ".wav" );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*! 2026-10-17
+Parse the command line, load the multi and the MIDI file and render the song
+block by block, splitting each block at the MIDI events. After the last event
+rendering continues until all voices are done or the tail time has passed.
+Writes either a mixdown of all output buses or one stem per bus and prints a
+summary of the render time and the disk underruns.
+\param argc The number of command line arguments
+\param argv The command line arguments
+\return 0 on success, 1 on invalid arguments or if a file couldn't be read or
+written
+*/
+/*----------------------------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+   uint32_t sampleRate = OFFLINERENDER_DEFAULTSAMPLERATE;
+   size_t blockSize = OFFLINERENDER_DEFAULTBLOCKSIZE;
+   size_t threads = 0;
+   double tail = OFFLINERENDER_DEFAULTTAIL;
+   bool stems = false;
+   std::vector<std::string> files;
+
+   // std::stoul() and std::stod() throw on values which aren't numbers
+   try
+   {
+      for( int i = 1; i < argc; i++ )
+      {
+         std::string arg = argv[i];
+         bool hasValue = i + 1 < argc;
+
+         if( arg == "--samplerate" && hasValue )
+            sampleRate = (uint32_t)std::stoul( argv[++i] );
+         else
+         if( arg == "--blocksize" && hasValue )
+            blockSize = std::stoul( argv[++i] );
+         else
+         if( arg == "--threads" && hasValue )
+            threads = std::stoul( argv[++i] );
+         else
+         if( arg == "--tail" && hasValue )
+            tail = std::stod( argv[++i] );
+         else
+         if( arg == "--stems" )
+            stems = true;
+         else
+         if( arg.size() > 1 && arg[0] == '-' )
+         {
+            usage();
+            return( 1 );
+         } else
+            files.push_back( arg );
+      }
+   } catch( const std::exception & )
+   {
+      usage();
+      return( 1 );
+   }
+
+   if( files.size() != 3 || sampleRate == 0 || blockSize == 0 )
+   {
+      usage();
+      return( 1 );
+   }
+
+   std::unique_ptr<SamplerEngine::Engine> pEngine( loadMulti( files[0] ) );
+   if( !pEngine )
+   {
+      fprintf( stderr, "Couldn't load multi %s\n", files[0].c_str() );
+      return( 1 );
+   }
+
+   std::unique_ptr<MidiFile> pMidi( MidiFile::load( files[1] ) );
+   if( !pMidi )
+   {
+      fprintf( stderr, "Couldn't load MIDI file %s\n", files[1].c_str() );
+      return( 1 );
+   }
+
+   pEngine->prepareToPlay( blockSize );
+   pEngine->setRealtime( false );
+   if( threads > 0 )
+   {
+      pEngine->setRenderThreads( threads );
+   }
+
+   // One stereo buffer per output bus
+   std::vector<float> busBuffer( SAMPLERENGINE_MAXOUTPUTBUSES * 2 * blockSize );
+   std::vector<SamplerEngine::OutputBus> buses;
+   for( size_t b = 0; b < SAMPLERENGINE_MAXOUTPUTBUSES; b++ )
+   {
+      float *pLeft = busBuffer.data() + ( b * 2 * blockSize );
+      buses.push_back( SamplerEngine::OutputBus( blockSize, { pLeft, pLeft + blockSize } ) );
+   }
+
+   std::vector<std::unique_ptr<WavWriter>> writers;
+   std::vector<std::string> writerFileNames;
+   for( size_t w = 0; w < ( stems ? SAMPLERENGINE_MAXOUTPUTBUSES : 1 ); w++ )
+   {
+      std::string fileName = stems ? stemFileName( files[2], w ) : files[2];
+      writers.push_back( std::make_unique<WavWriter>() );
+      writerFileNames.push_back( fileName );
+      if( !writers.back()->open( fileName, sampleRate ) )
+      {
+         fprintf( stderr, "Couldn't create %s\n", fileName.c_str() );
+         return( 1 );
+      }
+   }
+   std::vector<float> mixLeft( blockSize );
+   std::vector<float> mixRight( blockSize );
+
+   const std::vector<MidiEvent> &events = pMidi->events();
+   const uint64_t endOfEvents = (uint64_t)( pMidi->length() * sampleRate ) + 1;
+   const uint64_t endOfTail = endOfEvents + (uint64_t)( tail * sampleRate );
+   double bpm = pMidi->initialBpm();
+   size_t nEvent = 0;
+   uint64_t pos = 0;
+
+   auto startTime = std::chrono::steady_clock::now();
+
+   while( pos < endOfEvents || ( pos < endOfTail && pEngine->numActiveVoices() > 0 ) )
+   {
+      std::fill( busBuffer.begin(), busBuffer.end(), 0.0f );
+
+      // Split the block at the events, like PluginProcessor::processBlock()
+      size_t curSample = 0;
+      while( nEvent < events.size() )
+      {
+         uint64_t eventPos = (uint64_t)( events[nEvent].time * sampleRate );
+         if( eventPos >= pos + blockSize )
+            break;
+
+         size_t eventSample = eventPos > pos ? (size_t)( eventPos - pos ) : 0;
+         if( eventSample > curSample )
+         {
+            pEngine->process( buses, curSample, eventSample - curSample, sampleRate, bpm );
+            curSample = eventSample;
+         }
+
+         applyEvent( pEngine.get(), events[nEvent] );
+         bpm = events[nEvent].bpm;
+         nEvent++;
+      }
+
+      if( curSample < blockSize )
+      {
+         pEngine->process( buses, curSample, blockSize - curSample, sampleRate, bpm );
+      }
+
+      if( stems )
+      {
+         for( size_t b = 0; b < SAMPLERENGINE_MAXOUTPUTBUSES; b++ )
+         {
+            writers[b]->write( buses[b].getWritePointers()[0], buses[b].getWritePointers()[1], blockSize );
+         }
+      } else
+      {
+         std::fill( mixLeft.begin(), mixLeft.end(), 0.0f );
+         std::fill( mixRight.begin(), mixRight.end(), 0.0f );
+         for( size_t b = 0; b < SAMPLERENGINE_MAXOUTPUTBUSES; b++ )
+         {
+            for( size_t i = 0; i < blockSize; i++ )
+            {
+               mixLeft[i] += buses[b].getWritePointers()[0][i];
+               mixRight[i] += buses[b].getWritePointers()[1][i];
+            }
+         }
+         writers[0]->write( mixLeft.data(), mixRight.data(), blockSize );
+      }
+
+      pos += blockSize;
+   }
+
+   bool ok = true;
+   for( size_t w = 0; w < writers.size(); w++ )
+   {
+      if( !writers[w]->close() )
+      {
+         fprintf( stderr, "Couldn't write %s\n", writerFileNames[w].c_str() );
+         ok = false;
+      }
+   }
+
+   double renderSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+   double audioSeconds = (double)pos / (double)sampleRate;
+   printf( "Rendered %.2fs of audio in %.2fs (%.1fx realtime), %llu disk underruns\n",
+           audioSeconds, renderSeconds, renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0,
+           (unsigned long long)pEngine->host().numUnderruns() );
+
+   return( ok ? 0 : 1 );
+}